@@ -58,6 +58,13 @@ namespace Robomongo
          */
         const EventError &error() const { return _error; }
 
+        /**
+         * @brief Coalescable event, that is still waiting in the queue of receiver's
+         * thread, is replaced by the next event of the same type from the same sender
+         * (i.e. only latest progress update is delivered).
+         */
+        virtual bool isCoalescable() const { return false; }
+
     private:
         /**
          * @brief Sender that emits this event.
@@ -4,6 +4,8 @@
 #include <QCoreApplication>
 #include <QThread>
 #include <QMutexLocker>
+#include <algorithm>
+#include <iterator>
 
 #include "robomongo/core/EventBusDispatcher.h"
 #include "robomongo/core/EventBusSubscriber.h"
@@ -13,22 +15,7 @@
 
 namespace
 {
-    struct RemoveIfReciver : public std::unary_function<const Robomongo::EventBus::SubscribersType&, bool>
-    {
-        RemoveIfReciver(QObject *receiver) : _receiver(receiver) {}
-
-        bool operator()(const Robomongo::EventBus::SubscribersType& item) const {
-            if (item.second->receiver == _receiver) {
-                delete item.second;
-                return true;
-            }
-            return false;
-        }
-
-        QObject *_receiver;
-    };
-
-    struct FindIfReciver : public std::unary_function<const Robomongo::EventBus::SubscribersType&, bool>
+    struct FindIfReciver : public std::unary_function<const Robomongo::EventBus::DispatchersType&, bool>
     {
         FindIfReciver(QThread *thread) : _thread(thread) {}
         bool operator()(const Robomongo::EventBus::DispatchersType &item) const {
@@ -39,17 +26,30 @@ namespace
         }
         QThread *_thread;
     };
+
+    bool isSubscribedEarlier(const Robomongo::EventBusSubscriber *first, const Robomongo::EventBusSubscriber *second)
+    {
+        return first->order < second->order;
+    }
 }
 
 namespace Robomongo
 {
     EventBus::EventBus() : QObject(),
-        _lock(QMutex::Recursive)
+        _lock(QMutex::Recursive),
+        _subscriptionsCount(0)
     {
     }
 
     EventBus::~EventBus()
     {
+        for (SubscribersContainerType::iterator it = _subscribersByEventType.begin(); it != _subscribersByEventType.end(); ++it) {
+            SubscribersListType &list = it->second;
+            for (SubscribersListType::iterator sit = list.begin(); sit != list.end(); ++sit) {
+                delete *sit;
+            }
+        }
+
         for (DispatchersContainerType::iterator it = _dispatchersByThread.begin(); it != _dispatchersByThread.end(); ++it) {
             DispatchersType item = *it;
             delete item.second;
@@ -58,50 +58,67 @@ namespace Robomongo
 
     void EventBus::publish(Event *event)
     {
-        QMutexLocker lock(&_lock);
         QList<QObject*> theReceivers;
         EventBusDispatcher *dis = NULL;
-        for (SubscribersContainerType::iterator it = _subscribersByEventType.begin(); it != _subscribersByEventType.end(); ++it ) {
-            SubscribersType item = *it;
-            if (event->type() == item.first) {
-                EventBusSubscriber *subscriber = item.second;
-                if (!subscriber->sender || subscriber->sender == event->sender()) {
-                    theReceivers.append(subscriber->receiver);
-
-                    if (dis && dis != subscriber->dispatcher)
-                        throw "You cannot publish events to subscribers from more than one thread.";
-
-                    dis = subscriber->dispatcher;
-                }
+        {
+            QMutexLocker lock(&_lock);
+            const SubscribersListType *anySender = subscribers(event->type(), NULL);
+            const SubscribersListType *exactSender = event->sender() ? subscribers(event->type(), event->sender()) : NULL;
+
+            // Both lists are sorted by order of subscription, merge them to keep this order
+            std::vector<EventBusSubscriber *> theSubscribers;
+            if (anySender && exactSender) {
+                theSubscribers.reserve(anySender->size() + exactSender->size());
+                std::merge(anySender->begin(), anySender->end(), exactSender->begin(), exactSender->end(),
+                           std::back_inserter(theSubscribers), isSubscribedEarlier);
+            } else if (anySender) {
+                theSubscribers.assign(anySender->begin(), anySender->end());
+            } else if (exactSender) {
+                theSubscribers.assign(exactSender->begin(), exactSender->end());
+            }
+
+            for (std::vector<EventBusSubscriber *>::const_iterator it = theSubscribers.begin(); it != theSubscribers.end(); ++it) {
+                EventBusSubscriber *subscriber = *it;
+                theReceivers.append(subscriber->receiver);
+
+                if (dis && dis != subscriber->dispatcher)
+                    throw "You cannot publish events to subscribers from more than one thread.";
+
+                dis = subscriber->dispatcher;
             }
         }
 
+        // Sent without lock: posting may wait for the receiving thread (backpressure)
         if (dis)
             sendEvent(dis, new EventWrapper(event, theReceivers));
+        else
+            delete event;
     }
 
     void EventBus::send(QObject *receiver, Event *event)
     {
-        QMutexLocker lock(&_lock);
-
         if (!receiver)
             return;
 
-        QThread *thread = receiver->thread();
-        EventBusDispatcher *dis = dispatcher(thread);
+        EventBusDispatcher *dis = NULL;
+        {
+            QMutexLocker lock(&_lock);
+            dis = dispatcher(receiver->thread());
+        }
 
         sendEvent(dis, new EventWrapper(event, receiver));
     }
 
     void EventBus::send(QList<QObject *> receivers, Event *event)
     {
-        QMutexLocker lock(&_lock);
-
         if (receivers.count() == 0)
             return;
 
-        QThread *thread = receivers.last()->thread();
-        EventBusDispatcher *dis = dispatcher(thread);
+        EventBusDispatcher *dis = NULL;
+        {
+            QMutexLocker lock(&_lock);
+            dis = dispatcher(receivers.last()->thread());
+        }
 
         sendEvent(dis, new EventWrapper(event, receivers));
     }
@@ -115,17 +132,49 @@ namespace Robomongo
 
         // subscribe to destroyed signal in order to remove
         // listener (receiver) from list of subscribers
-        VERIFY(connect(receiver, SIGNAL(destroyed(QObject*)), this, SLOT(unsubscibe(QObject*))));
+        SubscriptionsContainerType::iterator subscriptions = _subscriptionsByReceiver.find(receiver);
+        if (subscriptions == _subscriptionsByReceiver.end()) {
+            VERIFY(connect(receiver, SIGNAL(destroyed(QObject*)), this, SLOT(unsubscibe(QObject*))));
+            subscriptions = _subscriptionsByReceiver.insert(std::make_pair(receiver, std::vector<SubscriptionType>())).first;
+        }
 
         // add subscriber
-        _subscribersByEventType.push_back(SubscribersType(type, new EventBusSubscriber(dis, receiver, sender)));
+        SubscriptionKeyType key(type, sender);
+        SubscribersListType &list = _subscribersByEventType[key];
+        SubscribersListType::iterator position = list.insert(list.end(), new EventBusSubscriber(dis, receiver, sender, ++_subscriptionsCount));
+        subscriptions->second.push_back(SubscriptionType(key, position));
     }
 
     void EventBus::unsubscibe(QObject *receiver)
     {
         QMutexLocker lock(&_lock);
-        _subscribersByEventType.erase(std::remove_if(_subscribersByEventType.begin(), _subscribersByEventType.end(),
-            RemoveIfReciver(receiver)), _subscribersByEventType.end());
+        SubscriptionsContainerType::iterator subscriptions = _subscriptionsByReceiver.find(receiver);
+        if (subscriptions == _subscriptionsByReceiver.end())
+            return;
+
+        const std::vector<SubscriptionType> &items = subscriptions->second;
+        for (std::vector<SubscriptionType>::const_iterator it = items.begin(); it != items.end(); ++it) {
+            SubscribersContainerType::iterator listIt = _subscribersByEventType.find(it->first);
+            if (listIt == _subscribersByEventType.end())
+                continue;
+
+            SubscribersListType &list = listIt->second;
+            delete *(it->second);
+            list.erase(it->second);
+            if (list.empty())
+                _subscribersByEventType.erase(listIt);
+        }
+
+        _subscriptionsByReceiver.erase(subscriptions);
+    }
+
+    const EventBus::SubscribersListType *EventBus::subscribers(QEvent::Type type, QObject *sender) const
+    {
+        SubscribersContainerType::const_iterator it = _subscribersByEventType.find(SubscriptionKeyType(type, sender));
+        if (it == _subscribersByEventType.end())
+            return NULL;
+
+        return &it->second;
     }
 
     /**
@@ -159,7 +208,7 @@ namespace Robomongo
             delete wrapper;
         }
         else {
-            QCoreApplication::postEvent(dispatcher, wrapper);
+            dispatcher->post(wrapper);
         }
     }
 
@@ -4,6 +4,8 @@
 #include <QEvent>
 #include <QMutex>
 #include <vector>
+#include <list>
+#include <map>
 
 namespace Robomongo
 {
@@ -21,8 +23,20 @@ namespace Robomongo
         Q_OBJECT
 
     public:
-        typedef std::pair<QEvent::Type, EventBusSubscriber *> SubscribersType;
-        typedef std::vector<SubscribersType > SubscribersContainerType;
+        /**
+         * @brief Subscribers are indexed by (event type, sender). Sender is NULL
+         * for subscribers, that receive events of this type from any sender.
+         */
+        typedef std::pair<QEvent::Type, QObject *> SubscriptionKeyType;
+        typedef std::list<EventBusSubscriber *> SubscribersListType;
+        typedef std::map<SubscriptionKeyType, SubscribersListType> SubscribersContainerType;
+
+        /**
+         * @brief Subscriptions of every receiver, so that it is unsubscribed
+         * without scan of all subscribers.
+         */
+        typedef std::pair<SubscriptionKeyType, SubscribersListType::iterator> SubscriptionType;
+        typedef std::map<QObject *, std::vector<SubscriptionType> > SubscriptionsContainerType;
         typedef std::pair<QThread *, EventBusDispatcher *> DispatchersType;
         typedef std::vector<DispatchersType> DispatchersContainerType;
         EventBus();
@@ -63,9 +77,16 @@ namespace Robomongo
 
         void sendEvent(EventBusDispatcher *dispatcher, EventWrapper *wrapper);
 
+        /**
+         * @brief Returns subscribers for the key or NULL, if there are no such subscribers.
+         */
+        const SubscribersListType *subscribers(QEvent::Type type, QObject *sender) const;
+
     private:
         QMutex _lock;
         SubscribersContainerType _subscribersByEventType;
+        SubscriptionsContainerType _subscriptionsByReceiver;
+        unsigned long long _subscriptionsCount;
         DispatchersContainerType _dispatchersByThread;
     };
 }
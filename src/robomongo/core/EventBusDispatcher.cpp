@@ -1,13 +1,70 @@
 #include "robomongo/core/EventBusDispatcher.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QMetaMethod>
+#include <QMutexLocker>
+#include <QThread>
+
 #include "robomongo/core/EventWrapper.h"
 
 namespace Robomongo
 {
 
     EventBusDispatcher::EventBusDispatcher(QObject *parent) :
-        QObject(parent)
+        QObject(parent),
+        _pendingCount(0)
+    {
+
+    }
+
+    void EventBusDispatcher::post(EventWrapper *wrapper)
     {
+        Event *event = wrapper->event();
+        CoalescingKeyType key(event->type(), event->sender());
+
+        QMutexLocker lock(&_pendingLock);
+        if (event->isCoalescable()) {
+            CoalescingContainerType::iterator it = _coalescable.find(key);
+            if (it != _coalescable.end()) {
+                EventWrapper *pending = it->second;
+                if (pending->receivers() == wrapper->receivers() && pending->event()->isCoalescable()) {
+                    pending->swapEvent(*wrapper);
+                    delete wrapper;
+                    return;
+                }
+            }
+        }
+
+        // Backpressure: workers are slowed down, when receiving thread is not able
+        // to process their events. GUI thread is never blocked.
+        QCoreApplication *app = QCoreApplication::instance();
+        if (app && QThread::currentThread() != app->thread()) {
+            QElapsedTimer waiting;
+            waiting.start();
+            while (_pendingCount >= maxPendingEvents && !waiting.hasExpired(backpressureTimeoutMs)) {
+                _pendingDecreased.wait(&_pendingLock, static_cast<unsigned long>(backpressureTimeoutMs - waiting.elapsed()));
+            }
+        }
+
+        if (event->isCoalescable())
+            _coalescable[key] = wrapper;
 
+        ++_pendingCount;
+        wrapper->setPosted();
+        QCoreApplication::postEvent(this, wrapper);
+    }
+
+    void EventBusDispatcher::delivered(EventWrapper *wrapper)
+    {
+        QMutexLocker lock(&_pendingLock);
+        Event *event = wrapper->event();
+        CoalescingContainerType::iterator it = _coalescable.find(CoalescingKeyType(event->type(), event->sender()));
+        if (it != _coalescable.end() && it->second == wrapper)
+            _coalescable.erase(it);
+
+        --_pendingCount;
+        _pendingDecreased.wakeAll();
     }
 
     bool EventBusDispatcher::event(QEvent *qevent)
@@ -17,14 +74,37 @@ namespace Robomongo
         if (!wrapper)
             return false;
 
+        // Synchronous events (sent from the thread of dispatcher) were not posted
+        if (wrapper->isPosted())
+            delivered(wrapper);
+
         Event *event = wrapper->event();
 
         const char *typeName = event->typeString();
         const QList<QObject*> &recivers = wrapper->receivers();
         for (QList<QObject*>::const_iterator it = recivers.begin(); it != recivers.end(); ++it) {
-            QMetaObject::invokeMethod(*it, "handle", QGenericArgument(typeName, &event));
+            QObject *receiver = *it;
+            int index = handlerIndex(receiver->metaObject(), event);
+            if (index < 0)
+                continue;
+
+            receiver->metaObject()->method(index).invoke(receiver, Qt::DirectConnection, QGenericArgument(typeName, &event));
         }
 
         return true;
     }
+
+    int EventBusDispatcher::handlerIndex(const QMetaObject *metaObject, Event *event)
+    {
+        HandlerKeyType key(metaObject, event->type());
+        HandlersContainerType::const_iterator it = _handlers.find(key);
+        if (it != _handlers.end())
+            return it->second;
+
+        // typeString() is "EventType*"
+        QByteArray signature = QByteArray("handle(") + event->typeString() + ")";
+        int index = metaObject->indexOfMethod(QMetaObject::normalizedSignature(signature.constData()).constData());
+        _handlers.insert(std::make_pair(key, index));
+        return index;
+    }
 }
@@ -1,17 +1,64 @@
 #pragma once
 #include <QObject>
+#include <QEvent>
+#include <QMutex>
+#include <QWaitCondition>
+#include <map>
 
 namespace Robomongo
 {
+    class Event;
+    class EventWrapper;
+
     /**
      * @brief The EventBusDispatcher class
+     * Delivers events to receivers, living in the thread of dispatcher,
+     * by calling their "handle(EventType*)" slot.
      */
     class EventBusDispatcher : public QObject
     {
         Q_OBJECT
     public:
+        /**
+         * @brief Number of posted, but not yet delivered events, after which
+         * posting thread waits (at most backpressureTimeoutMs) for the dispatcher.
+         * Main (GUI) thread never waits.
+         */
+        enum{maxPendingEvents = 1000, backpressureTimeoutMs = 1000};
+
         EventBusDispatcher(QObject *parent = 0);
+
+        /**
+         * @brief Posts event from other thread. Coalescable event replaces
+         * pending event of the same type from the same sender to the same receivers.
+         */
+        void post(EventWrapper *wrapper);
+
     protected:
         virtual bool event(QEvent *qevent);
+
+    private:
+        /**
+         * @brief Returns index of "handle" slot of receiver's class for specified event,
+         * or -1 if class has no such slot. Index is resolved once per (class, event type).
+         */
+        int handlerIndex(const QMetaObject *metaObject, Event *event);
+
+        /**
+         * @brief Wrapper is taken from the queue for delivery.
+         */
+        void delivered(EventWrapper *wrapper);
+
+        typedef std::pair<const QMetaObject *, QEvent::Type> HandlerKeyType;
+        typedef std::map<HandlerKeyType, int> HandlersContainerType;
+        HandlersContainerType _handlers;
+
+        typedef std::pair<QEvent::Type, QObject *> CoalescingKeyType;
+        typedef std::map<CoalescingKeyType, EventWrapper *> CoalescingContainerType;
+
+        QMutex _pendingLock;
+        QWaitCondition _pendingDecreased;
+        int _pendingCount;
+        CoalescingContainerType _coalescable;
     };
 }
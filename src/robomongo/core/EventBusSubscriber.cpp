@@ -3,8 +3,9 @@
 
 namespace Robomongo
 {
-    EventBusSubscriber::EventBusSubscriber(EventBusDispatcher *dispatcher, QObject *receiver, QObject *sender) :
+    EventBusSubscriber::EventBusSubscriber(EventBusDispatcher *dispatcher, QObject *receiver, QObject *sender, unsigned long long order) :
         receiver(receiver),
         dispatcher(dispatcher),
-        sender(sender) {}
+        sender(sender),
+        order(order) {}
 }
@@ -7,9 +7,14 @@ namespace Robomongo
     class EventBusDispatcher;
     struct EventBusSubscriber
     {
-        EventBusSubscriber(EventBusDispatcher *dispatcher, QObject *receiver, QObject *sender = 0);
+        /**
+         * @param order: sequence number of subscription, events are delivered
+         * to subscribers in order of subscription.
+         */
+        EventBusSubscriber(EventBusDispatcher *dispatcher, QObject *receiver, QObject *sender = 0, unsigned long long order = 0);
         EventBusDispatcher *const dispatcher;
         QObject *const receiver;
         QObject *const sender;
+        const unsigned long long order;
     };
 }
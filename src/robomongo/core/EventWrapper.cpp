@@ -2,10 +2,10 @@
 namespace Robomongo
 {
     EventWrapper::EventWrapper(Event *event, QList<QObject *> receivers) 
-        : QEvent(event->type()), _event(event), _receivers(receivers) {}
+        : QEvent(event->type()), _event(event), _receivers(receivers), _isPosted(false) {}
 
     EventWrapper::EventWrapper(Event *event, QObject * receiver)
-        : QEvent(event->type()), _event(event), _receivers(QList<QObject *>() << receiver ) {}
+        : QEvent(event->type()), _event(event), _receivers(QList<QObject *>() << receiver ), _isPosted(false) {}
 
     Event *EventWrapper::event() const 
     {
@@ -16,4 +16,9 @@ namespace Robomongo
     {
         return _receivers;
     }
+
+    void EventWrapper::swapEvent(EventWrapper &other)
+    {
+        _event.swap(other._event);
+    }
 }
@@ -12,8 +12,21 @@ namespace Robomongo
         Event *event() const;
         const QList<QObject *> &receivers() const;
 
+        /**
+         * @brief Exchanges wrapped events, used to replace event, waiting
+         * in the queue, with the newer event of the same type.
+         */
+        void swapEvent(EventWrapper &other);
+
+        /**
+         * @brief Wrapper was posted to the queue of other thread.
+         */
+        bool isPosted() const { return _isPosted; }
+        void setPosted() { _isPosted = true; }
+
     private:
-        const boost::scoped_ptr<Event> _event;
+        boost::scoped_ptr<Event> _event;
         const QList<QObject *> _receivers;
+        bool _isPosted;
     };
 }
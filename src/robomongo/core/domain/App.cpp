@@ -98,8 +98,8 @@ namespace Robomongo
 
     MongoShell *App::openShell(ConnectionSettings *connection, const ScriptInfo &scriptInfo)
     {
-        MongoServer *server = openServer(connection, false);
-        MongoShell *shell = new MongoShell(server,scriptInfo);
+        MongoServer *server = acquireShellServer(connection);
+        MongoShell *shell = new MongoShell(server,scriptInfo,connection->defaultDatabase());
         _shells.push_back(shell);
         _bus->publish(new OpeningShellEvent(this, shell));
         LOG_MSG("Opening shell...", mongo::LL_INFO);
@@ -119,7 +119,35 @@ namespace Robomongo
             return;
 
         _shells.erase(it);
-        closeServer(shell->server());
+        shell->close();
+        releaseShellServer(shell->server());
         delete shell;
     }
+
+    MongoServer *App::acquireShellServer(ConnectionSettings *connection)
+    {
+        for (ShellServersContainerType::iterator it = _shellServers.begin(); it != _shellServers.end(); ++it) {
+            if (it->first->connectionRecord()->isSameConnection(connection)) {
+                it->second++;
+                return it->first;
+            }
+        }
+
+        MongoServer *server = openServer(connection, false);
+        _shellServers[server] = 1;
+        return server;
+    }
+
+    void App::releaseShellServer(MongoServer *server)
+    {
+        ShellServersContainerType::iterator it = _shellServers.find(server);
+        if (it == _shellServers.end())
+            return;
+
+        if (--it->second > 0)
+            return;
+
+        _shellServers.erase(it);
+        closeServer(server);
+    }
 }
@@ -1,6 +1,7 @@
 #pragma once
 #include <QObject>
 #include <vector>
+#include <map>
 
 #include "robomongo/core/domain/ScriptInfo.h"
 
@@ -36,6 +37,7 @@ namespace Robomongo
     public:
         typedef std::vector<MongoServer*> MongoServersContainerType;
         typedef std::vector<MongoShell*> MongoShellsContainerType;
+        typedef std::map<MongoServer*, int> ShellServersContainerType;
         App(EventBus *const bus);
         ~App();
 
@@ -75,11 +77,23 @@ namespace Robomongo
         void closeShell(MongoShell *shell);
 
     private:
+        /**
+         * @brief Returns hidden server, shared by shells opened on the same connection.
+         * Server is created for the first shell and closed with the last one.
+         */
+        MongoServer *acquireShellServer(ConnectionSettings *connection);
+        void releaseShellServer(MongoServer *server);
+
         /**
          * @brief MongoServers, owned by this App.
          */
         MongoServersContainerType _servers;
 
+        /**
+         * @brief Servers of shells with number of shells, that use every server.
+         */
+        ShellServersContainerType _shellServers;
+
         /**
          * @brief MongoShells, owned by this App.
          */
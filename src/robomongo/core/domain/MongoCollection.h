@@ -1,5 +1,7 @@
 #pragma once
 
+#include <QElapsedTimer>
+
 #include "robomongo/core/domain/MongoDatabase.h"
 #include "robomongo/core/domain/MongoCollectionInfo.h"
 
@@ -10,10 +12,23 @@ namespace Robomongo
     public:
         MongoCollection(MongoDatabase *database, const MongoCollectionInfo &info);
 
+        /**
+         * @brief Loaded statistics are cached for this time.
+         */
+        enum{statsTtlMs = 5*60*1000};
+
         bool isSystem() const { return _system; }
 
         std::string name() const { return _ns.collectionName(); }
         const MongoCollectionInfo info() const { return _info; }
+        void setInfo(const MongoCollectionInfo &info) { _info = info; }
+
+        /**
+         * @brief Returns true, if statistics were not requested yet or
+         * were requested more than statsTtlMs ago.
+         */
+        bool isStatsExpired() const { return !_statsRequested.isValid() || _statsRequested.hasExpired(statsTtlMs); }
+        void markStatsRequested() { _statsRequested.start(); }
         std::string fullName() const { return _ns.toString(); }
         MongoDatabase *database() const { return _database; }
 
@@ -26,5 +41,6 @@ namespace Robomongo
         bool _system;
         MongoCollectionInfo _info;
         MongoNamespace _ns;
+        QElapsedTimer _statsRequested;
     };
 }
@@ -4,7 +4,8 @@
 
 namespace Robomongo
 {
-    MongoCollectionInfo::MongoCollectionInfo(mongo::BSONObj stats) : _ns(stats.getStringField("ns"))
+    MongoCollectionInfo::MongoCollectionInfo(mongo::BSONObj stats) : _ns(stats.getStringField("ns")),
+        _hasStats(true)
     {
         // if "size" and "storageSize" are of type Int32 or Int64, they
         // will be converted to double by "numberDouble()" function.
@@ -14,5 +15,13 @@ namespace Robomongo
         // NumberLong because of mongodb can have very big collections
         _count = BsonUtils::getField<mongo::NumberLong>(stats,"count");
     }
+
+    MongoCollectionInfo::MongoCollectionInfo(const MongoNamespace &ns) : _ns(ns),
+        _sizeBytes(0),
+        _storageSizeBytes(0),
+        _count(0),
+        _hasStats(false)
+    {
+    }
 }
 
@@ -9,6 +9,12 @@ namespace Robomongo
     public:
         MongoCollectionInfo(mongo::BSONObj stats);
 
+        /**
+         * @brief Collection without loaded statistics (only name is known).
+         */
+        explicit MongoCollectionInfo(const MongoNamespace &ns);
+        bool hasStats() const { return _hasStats; }
+
         std::string name() const { return _ns.collectionName(); }
         std::string fullName() const { return _ns.toString(); }
         MongoNamespace ns() const { return _ns; }
@@ -47,6 +53,7 @@ namespace Robomongo
         double _storageSizeBytes;
 
         long long _count;
+        bool _hasStats;
     };
 }
 
@@ -1,8 +1,11 @@
 #include "robomongo/core/domain/MongoDatabase.h"
 
+#include <algorithm>
+
 #include "robomongo/core/domain/MongoServer.h"
 #include "robomongo/core/domain/MongoCollection.h"
 #include "robomongo/core/mongodb/MongoWorker.h"
+#include "robomongo/core/settings/SettingsManager.h"
 #include "robomongo/core/AppRegistry.h"
 #include "robomongo/core/EventBus.h"
 
@@ -10,6 +13,7 @@ namespace Robomongo
 {
 
     R_REGISTER_EVENT(MongoDatabaseCollectionListLoadedEvent)
+    R_REGISTER_EVENT(MongoDatabaseCollectionsStatsLoadedEvent)
     R_REGISTER_EVENT(MongoDatabaseUsersLoadedEvent)
     R_REGISTER_EVENT(MongoDatabaseFunctionsLoadedEvent)
     R_REGISTER_EVENT(MongoDatabaseUsersLoadingEvent)
@@ -27,13 +31,31 @@ namespace Robomongo
 
     MongoDatabase::~MongoDatabase()
     {
+        cancelOperations();
         clearCollections();
     }
 
     void MongoDatabase::loadCollections()
     {
         _bus->publish(new MongoDatabaseCollectionsLoadingEvent(this));
-        _bus->send(_server->client(), new LoadCollectionNamesRequest(this, _name));
+        bool loadStats = !AppRegistry::instance().settingsManager()->lazyCollectionStats();
+        _bus->send(_server->client(), new LoadCollectionNamesRequest(this, _name, loadStats));
+    }
+
+    void MongoDatabase::loadCollectionStats(const std::vector<MongoCollection *> &collections)
+    {
+        std::vector<std::string> namespaces;
+        for (std::vector<MongoCollection *>::const_iterator it = collections.begin(); it != collections.end(); ++it) {
+            MongoCollection *collection = *it;
+            if (!collection->isStatsExpired())
+                continue;
+
+            collection->markStatsRequested();
+            namespaces.push_back(collection->fullName());
+        }
+
+        if (namespaces.size())
+            _bus->send(_server->client(), new LoadCollectionStatsRequest(this, _name, namespaces));
     }
 
     void MongoDatabase::loadUsers()
@@ -64,12 +86,24 @@ namespace Robomongo
 
     void MongoDatabase::duplicateCollection(const std::string &collection, const std::string &newCollection)
     {
-        _bus->send(_server->client(), new DuplicateCollectionRequest(this, MongoNamespace(_name, collection), newCollection));
+        OperationTokenPtr token(new OperationToken());
+        _operations.push_back(token);
+        _bus->send(_server->client(MongoServer::BulkRequests), new DuplicateCollectionRequest(this, MongoNamespace(_name, collection), newCollection, token));
     }
 
     void MongoDatabase::copyCollection(MongoServer *server, const std::string &sourceDatabase, const std::string &collection)
     {
-        _bus->send(_server->client(), new CopyCollectionToDiffServerRequest(this, server->client(), sourceDatabase, collection, _name));
+        OperationTokenPtr token(new OperationToken());
+        _operations.push_back(token);
+        _bus->send(_server->client(MongoServer::BulkRequests), new CopyCollectionToDiffServerRequest(this, server->client(MongoServer::BulkRequests), sourceDatabase, collection, _name, token));
+    }
+
+    void MongoDatabase::cancelOperations()
+    {
+        for (std::vector<OperationTokenPtr>::const_iterator it = _operations.begin(); it != _operations.end(); ++it) {
+            (*it)->cancel();
+        }
+        _operations.clear();
     }
 
     void MongoDatabase::createUser(const MongoUser &user, bool overwrite)
@@ -103,16 +137,44 @@ namespace Robomongo
             return;
 
         clearCollections();
+
+        // Statistics of all collections are already loading
+        bool isStatsRequested = !AppRegistry::instance().settingsManager()->lazyCollectionStats();
         const std::vector<MongoCollectionInfo> &colectionsInfos = loaded->collectionInfos();
         for (std::vector<MongoCollectionInfo>::const_iterator it = colectionsInfos.begin(); it != colectionsInfos.end(); ++it) {
             const MongoCollectionInfo &info = *it;
             MongoCollection *collection = new MongoCollection(this, info);
+            if (isStatsRequested)
+                collection->markStatsRequested();
             addCollection(collection);
         }
 
         _bus->publish(new MongoDatabaseCollectionListLoadedEvent(this, _collections));
     }
 
+    void MongoDatabase::handle(LoadCollectionStatsResponse *event)
+    {
+        if (event->isError())
+            return;
+
+        std::vector<MongoCollection *> updated;
+        const std::vector<MongoCollectionInfo> &infos = event->collectionInfos();
+        for (std::vector<MongoCollectionInfo>::const_iterator it = infos.begin(); it != infos.end(); ++it) {
+            const MongoCollectionInfo &info = *it;
+            for (std::vector<MongoCollection *>::const_iterator cit = _collections.begin(); cit != _collections.end(); ++cit) {
+                MongoCollection *collection = *cit;
+                if (collection->fullName() == info.fullName()) {
+                    collection->setInfo(info);
+                    updated.push_back(collection);
+                    break;
+                }
+            }
+        }
+
+        if (updated.size())
+            _bus->publish(new MongoDatabaseCollectionsStatsLoadedEvent(this, updated));
+    }
+
     void MongoDatabase::handle(CreateUserResponse *event)
     {
         if (event->isError())
@@ -120,6 +182,14 @@ namespace Robomongo
 
     }
 
+    void MongoDatabase::handle(OperationProgressEvent *event)
+    {
+        if (event->isFinished())
+            _operations.erase(std::remove(_operations.begin(), _operations.end(), event->token()), _operations.end());
+
+        _bus->publish(new OperationProgressEvent(this, *event));
+    }
+
     void MongoDatabase::handle(LoadUsersResponse *event)
     {
         if (event->isError())
@@ -30,6 +30,11 @@ namespace Robomongo
          */
         void loadCollections();
 
+        /**
+         * @brief Loads statistics of 'collections', for which it is not cached.
+         */
+        void loadCollectionStats(const std::vector<MongoCollection *> &collections);
+
         /**
          * @brief Initiate loadUsers asynchronous operation.
          */
@@ -43,6 +48,11 @@ namespace Robomongo
         void duplicateCollection(const std::string &collection, const std::string &newCollection);
         void copyCollection(MongoServer *server, const std::string &sourceDatabase, const std::string &collection);
 
+        /**
+         * @brief Cancels running duplicate/copy collection operations.
+         */
+        void cancelOperations();
+
         void createUser(const MongoUser &user, bool overwrite);
         void dropUser(const mongo::OID &id);
 
@@ -62,9 +72,11 @@ namespace Robomongo
 
     protected Q_SLOTS:
         void handle(LoadCollectionNamesResponse *event);
+        void handle(LoadCollectionStatsResponse *event);
         void handle(LoadUsersResponse *event);
         void handle(LoadFunctionsResponse *event);
         void handle(CreateUserResponse *event);
+        void handle(OperationProgressEvent *event);
 
     private:
         void clearCollections();
@@ -73,6 +85,7 @@ namespace Robomongo
     private:
         MongoServer *_server;
         std::vector<MongoCollection *> _collections;
+        std::vector<OperationTokenPtr> _operations;
         const std::string _name;
         const bool _system;
         EventBus *_bus;
@@ -89,6 +102,20 @@ namespace Robomongo
         std::vector<MongoCollection *> collections;
     };
 
+    /**
+     * @brief Statistics of 'collections' were loaded (collections list itself is not changed).
+     */
+    class MongoDatabaseCollectionsStatsLoadedEvent : public Event
+    {
+        R_EVENT
+
+        MongoDatabaseCollectionsStatsLoadedEvent(QObject *sender, const std::vector<MongoCollection *> &list) :
+            Event(sender),
+            collections(list) { }
+
+        std::vector<MongoCollection *> collections;
+    };
+
     class MongoDatabaseUsersLoadedEvent : public Event
     {
         R_EVENT
@@ -7,6 +7,7 @@
 #include "robomongo/core/AppRegistry.h"
 #include "robomongo/core/EventBus.h"
 #include "robomongo/core/utils/QtUtils.h"
+#include "robomongo/core/utils/StdUtils.h"
 
 namespace Robomongo
 {
@@ -15,9 +16,19 @@ namespace Robomongo
     MongoServer::MongoServer(ConnectionSettings *connectionRecord, bool visible) : QObject(),
         _version(0.0f),
         _visible(visible),
-        _client(new MongoWorker(connectionRecord->clone(),AppRegistry::instance().settingsManager()->loadMongoRcJs(),AppRegistry::instance().settingsManager()->batchSize())),
         _isConnected(false)
     {
+        SettingsManager *settings = AppRegistry::instance().settingsManager();
+        int count = std::min<int>(settings->connectionsPerServer(), RequestKindsCount);
+        for (int i = 0; i < count; ++i) {
+            bool hasScriptEngine = i == ScriptRequests % count;
+            _workers.push_back(new MongoWorker(connectionRecord->clone(), settings->loadMongoRcJs(), settings->batchSize(), hasScriptEngine));
+        }
+    }
+
+    MongoWorker *MongoServer::client(RequestKind kind) const
+    {
+        return _workers[kind % _workers.size()];
     }
 
     bool MongoServer::isConnected() const
@@ -27,13 +38,13 @@ namespace Robomongo
 
     ConnectionSettings *MongoServer::connectionRecord() const 
     { 
-        return _client->connectionRecord(); 
+        return client()->connectionRecord(); 
     }
 
     MongoServer::~MongoServer()
     {        
         clearDatabases();
-        delete _client;
+        std::for_each(_workers.begin(), _workers.end(), stdutils::default_delete<MongoWorker *>());
     }
 
     /**
@@ -42,7 +53,7 @@ namespace Robomongo
      */
     void MongoServer::tryConnect()
     {
-        AppRegistry::instance().bus()->send(_client,new EstablishConnectionRequest(this,
+        AppRegistry::instance().bus()->send(client(),new EstablishConnectionRequest(this,
             "_connectionRecord->databaseName()",
             "_connectionRecord->userName()",
             "_connectionRecord->userPassword()"));
@@ -60,7 +71,7 @@ namespace Robomongo
 
     void MongoServer::createDatabase(const std::string &dbName)
     {
-        AppRegistry::instance().bus()->send(_client,new CreateDatabaseRequest(this, dbName));
+        AppRegistry::instance().bus()->send(client(),new CreateDatabaseRequest(this, dbName));
     }
 
     MongoDatabase *MongoServer::findDatabaseByName(const std::string &dbName) const
@@ -76,19 +87,22 @@ namespace Robomongo
 
     void MongoServer::dropDatabase(const std::string &dbName)
     {
-        AppRegistry::instance().bus()->send(_client,new DropDatabaseRequest(this, dbName));
+        OperationTokenPtr token(new OperationToken());
+        AppRegistry::instance().bus()->send(client(BulkRequests), new DropDatabaseRequest(this, dbName, token));
     }
 
     void MongoServer::insertDocuments(const std::vector<mongo::BSONObj> &objCont, const MongoNamespace &ns)
     {
-        for (std::vector<mongo::BSONObj>::const_iterator it = objCont.begin(); it != objCont.end(); it++) {
-            insertDocument(*it, ns);
-        }
+        if (objCont.empty())
+            return;
+
+        OperationTokenPtr token(new OperationToken());
+        AppRegistry::instance().bus()->send(client(BulkRequests), new InsertDocumentsRequest(this, objCont, ns, token));
     }
 
     void MongoServer::insertDocument(const mongo::BSONObj &obj, const MongoNamespace &ns)
     {
-        AppRegistry::instance().bus()->send(_client,new InsertDocumentRequest(this, obj, ns));
+        AppRegistry::instance().bus()->send(client(),new InsertDocumentRequest(this, obj, ns));
     }
 
     void MongoServer::saveDocuments(const std::vector<mongo::BSONObj> &objCont, const MongoNamespace &ns)
@@ -100,18 +114,33 @@ namespace Robomongo
 
     void MongoServer::saveDocument(const mongo::BSONObj &obj, const MongoNamespace &ns)
     {
-        AppRegistry::instance().bus()->send(_client, new InsertDocumentRequest(this, obj, ns, true));
+        AppRegistry::instance().bus()->send(client(), new InsertDocumentRequest(this, obj, ns, true));
+    }
+
+    void MongoServer::updateDocument(const mongo::BSONObj &original, const mongo::BSONObj &edited, const MongoNamespace &ns,
+                                     bool checkConflicts)
+    {
+        AppRegistry::instance().bus()->send(client(), new UpdateDocumentRequest(this, original, edited, ns, checkConflicts));
     }
 
     void MongoServer::removeDocuments(mongo::Query query, const MongoNamespace &ns, bool justOne)
     {
-        AppRegistry::instance().bus()->send(_client, new RemoveDocumentRequest(this, query, ns, justOne));
+        AppRegistry::instance().bus()->send(client(), new RemoveDocumentRequest(this, query, ns, justOne));
+    }
+
+    void MongoServer::removeDocuments(const std::vector<mongo::BSONObj> &ids, const MongoNamespace &ns)
+    {
+        if (ids.empty())
+            return;
+
+        OperationTokenPtr token(new OperationToken());
+        AppRegistry::instance().bus()->send(client(), new RemoveDocumentsRequest(this, ids, ns, token));
     }
 
     void MongoServer::loadDatabases()
     {
         AppRegistry::instance().bus()->publish(new MongoServerLoadingDatabasesEvent(this));
-        AppRegistry::instance().bus()->send(_client, new LoadDatabaseNamesRequest(this));
+        AppRegistry::instance().bus()->send(client(), new LoadDatabaseNamesRequest(this));
     }
 
     void MongoServer::clearDatabases()
@@ -164,4 +193,24 @@ namespace Robomongo
     {
         AppRegistry::instance().bus()->publish(new InsertDocumentResponse(event->sender(), event->error()));
     }
+
+    void MongoServer::handle(InsertDocumentsResponse *event)
+    {
+        AppRegistry::instance().bus()->publish(new InsertDocumentsResponse(this, event->ns(), event->documents(), event->inserted(), event->error()));
+    }
+
+    void MongoServer::handle(RemoveDocumentsResponse *event)
+    {
+        AppRegistry::instance().bus()->publish(new RemoveDocumentsResponse(this, event->ns(), event->ids(), event->removed(), event->error()));
+    }
+
+    void MongoServer::handle(UpdateDocumentResponse *event)
+    {
+        AppRegistry::instance().bus()->publish(new UpdateDocumentResponse(this, event->ns(), event->original(), event->edited(), event->error()));
+    }
+
+    void MongoServer::handle(OperationProgressEvent *event)
+    {
+        AppRegistry::instance().bus()->publish(new OperationProgressEvent(this, *event));
+    }
 }
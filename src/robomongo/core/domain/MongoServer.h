@@ -11,11 +11,17 @@ namespace Robomongo
     class EstablishConnectionResponse;
     class LoadDatabaseNamesResponse;
     class InsertDocumentResponse;
+    class InsertDocumentsResponse;
+    class RemoveDocumentsResponse;
+    class UpdateDocumentResponse;
 
     /**
      * @brief MongoServer represents active connection to MongoDB server.
      * MongoServer is an Aggregate Root, that manages three internal entities:
      * MongoDatabase, MongoCollection and MongoWorker.
+     *
+     * Server has small pool of MongoWorkers (each with its own thread and connection),
+     * so that heavy operation doesn't block other requests to the same server.
      */
     class MongoServer : public QObject
     {
@@ -29,6 +35,21 @@ namespace Robomongo
          * @param defaultDatabase
          */
         typedef QList<MongoDatabase *> DatabasesContainerType;
+        typedef std::vector<MongoWorker *> WorkersContainerType;
+
+        /**
+         * @brief Kinds of requests, every kind is routed to its own worker
+         * (if pool has enough workers).
+         */
+        enum RequestKind
+        {
+            MetadataRequests = 0, // explorer, indexes, users, functions, documents editing
+            ScriptRequests,       // shell scripts and autocompletion (worker with ScriptEngine)
+            QueryRequests,        // paging of query results
+            BulkRequests,         // copying of collections, dropping of databases
+            RequestKindsCount
+        };
+
         MongoServer(ConnectionSettings *connectionRecord, bool visible);
         ~MongoServer();
 
@@ -44,11 +65,28 @@ namespace Robomongo
         QStringList getDatabasesNames() const;
         MongoDatabase *findDatabaseByName(const std::string &dbName) const;
 
+        /**
+         * @brief Inserts all documents with single worker request (in batches),
+         * InsertDocumentsResponse is published once, when all batches are done.
+         */
         void insertDocuments(const std::vector<mongo::BSONObj> &objCont, const MongoNamespace &ns);
         void insertDocument(const mongo::BSONObj &obj, const MongoNamespace &ns);
         void saveDocuments(const std::vector<mongo::BSONObj> &objCont, const MongoNamespace &ns);
         void saveDocument(const mongo::BSONObj &obj, const MongoNamespace &ns);
+
+        /**
+         * @brief Saves changed fields of 'edited' version of 'original' document,
+         * UpdateDocumentResponse is published when it is done.
+         */
+        void updateDocument(const mongo::BSONObj &original, const mongo::BSONObj &edited, const MongoNamespace &ns,
+                            bool checkConflicts);
         void removeDocuments(mongo::Query query, const MongoNamespace &ns, bool justOne = true);
+
+        /**
+         * @brief Removes documents by 'ids' ({ _id : value } objects) with single worker
+         * request, RemoveDocumentsResponse is published when all of them are removed.
+         */
+        void removeDocuments(const std::vector<mongo::BSONObj> &ids, const MongoNamespace &ns);
         float version() const{ return _version; }
 
 
@@ -62,18 +100,22 @@ namespace Robomongo
          */
         void loadDatabases();
         bool visible() const { return _visible; }
-        MongoWorker *const client() const { return _client; }
+        MongoWorker *client(RequestKind kind = MetadataRequests) const;
 
     protected Q_SLOTS:
         void handle(EstablishConnectionResponse *event);
         void handle(LoadDatabaseNamesResponse *event);
         void handle(InsertDocumentResponse *event);
+        void handle(InsertDocumentsResponse *event);
+        void handle(RemoveDocumentsResponse *event);
+        void handle(UpdateDocumentResponse *event);
+        void handle(OperationProgressEvent *event);
 
     private:
         void clearDatabases();
         void addDatabase(MongoDatabase *database);
 
-        MongoWorker *const _client;
+        WorkersContainerType _workers;
 
         float _version;
         bool _visible;
@@ -13,18 +13,22 @@
 namespace Robomongo
 {
 
-    MongoShell::MongoShell(MongoServer *server, const ScriptInfo &scriptInfo) :
+    MongoShell::MongoShell(MongoServer *server, const ScriptInfo &scriptInfo, const std::string &defaultDatabase) :
         QObject(),
         _scriptInfo(scriptInfo),
         _server(server)
     {
+        // Scope is created before any request of the shell (autocompletion may come before execution)
+        AppRegistry::instance().bus()->send(_server->client(MongoServer::ScriptRequests), new CreateScriptScopeRequest(this, defaultDatabase));
     }
 
     void MongoShell::open(const std::string &script, const std::string &dbName)
     {
+        // Results of the previous execution are replaced
+        releaseCursors();
         AppRegistry::instance().bus()->publish(new ScriptExecutingEvent(this));
         _scriptInfo.setScript(QtUtils::toQString(script));
-        AppRegistry::instance().bus()->send(_server->client(), new ExecuteScriptRequest(this, query(), dbName));
+        AppRegistry::instance().bus()->send(_server->client(MongoServer::ScriptRequests), new ExecuteScriptRequest(this, query(), dbName));
         LOG_MSG(_scriptInfo.script(), mongo::LL_INFO);
     }
 
@@ -35,21 +39,40 @@ namespace Robomongo
 
     void MongoShell::execute(const std::string &dbName)
     {
+        // Results of the previous execution are replaced
+        releaseCursors();
         if (_scriptInfo.execute()) {
             AppRegistry::instance().bus()->publish(new ScriptExecutingEvent(this));
-            AppRegistry::instance().bus()->send(_server->client(), new ExecuteScriptRequest(this, query(), dbName));
+            AppRegistry::instance().bus()->send(_server->client(MongoServer::ScriptRequests), new ExecuteScriptRequest(this, query(), dbName));
             if(!_scriptInfo.script().isEmpty())
                 LOG_MSG(_scriptInfo.script(), mongo::LL_INFO);
         } else {
             AppRegistry::instance().bus()->publish(new ScriptExecutingEvent(this));
             _scriptInfo.setScript("");
-            AppRegistry::instance().bus()->send(_server->client(), new ExecuteScriptRequest(this,query() , dbName));
+            AppRegistry::instance().bus()->send(_server->client(MongoServer::ScriptRequests), new ExecuteScriptRequest(this,query() , dbName));
         }
     }
 
     void MongoShell::query(int resultIndex, const MongoQueryInfo &info)
     {
-        AppRegistry::instance().bus()->send(_server->client(), new ExecuteQueryRequest(this, resultIndex, info));
+        OperationTokenPtr &token = _queryTokens[resultIndex];
+        if (token)
+            token->cancel();
+
+        token.reset(new OperationToken());
+        AppRegistry::instance().bus()->send(_server->client(MongoServer::QueryRequests), new ExecuteQueryRequest(this, resultIndex, info, token));
+    }
+
+    void MongoShell::releaseCursors()
+    {
+        cancelQueries();
+        AppRegistry::instance().bus()->send(_server->client(MongoServer::QueryRequests), new ReleaseQueryCursorsRequest(this));
+    }
+
+    void MongoShell::close()
+    {
+        releaseCursors();
+        AppRegistry::instance().bus()->send(_server->client(MongoServer::ScriptRequests), new ReleaseScriptScopeRequest(this));
     }
 
     void MongoShell::autocomplete(const std::string &prefix)
@@ -57,12 +80,21 @@ namespace Robomongo
         AutocompletionMode autocompletionMode = AppRegistry::instance().settingsManager()->autocompletionMode();
         if (autocompletionMode == AutocompleteNone)
             return;
-        AppRegistry::instance().bus()->send(_server->client(), new AutocompleteRequest(this, prefix, autocompletionMode));
+        AppRegistry::instance().bus()->send(_server->client(MongoServer::ScriptRequests), new AutocompleteRequest(this, prefix, autocompletionMode));
     }
 
     void MongoShell::stop()
     {
         mongo::Scope::setInterruptFlag(true);
+        cancelQueries();
+    }
+
+    void MongoShell::cancelQueries()
+    {
+        for (std::map<int, OperationTokenPtr>::const_iterator it = _queryTokens.begin(); it != _queryTokens.end(); ++it) {
+            it->second->cancel();
+        }
+        _queryTokens.clear();
     }
 
     bool MongoShell::loadFromFile()
@@ -82,7 +114,8 @@ namespace Robomongo
 
     void MongoShell::handle(ExecuteQueryResponse *event)
     {
-        AppRegistry::instance().bus()->publish(new DocumentListLoadedEvent(this, event->resultIndex, event->queryInfo, query(), event->documents));
+        AppRegistry::instance().bus()->publish(new DocumentListLoadedEvent(this, event->resultIndex, event->queryInfo, query(), event->documents,
+            event->isFirstPart, event->isLastPart));
     }
 
     void MongoShell::handle(ExecuteScriptResponse *event)
@@ -94,4 +127,9 @@ namespace Robomongo
     {
         AppRegistry::instance().bus()->publish(new AutocompleteResponse(this, event->list, event->prefix));
     }
+
+    void MongoShell::handle(OperationProgressEvent *event)
+    {
+        AppRegistry::instance().bus()->publish(new OperationProgressEvent(this, *event));
+    }
 }
@@ -1,5 +1,6 @@
 #pragma once
 #include <QObject>
+#include <map>
 #include "robomongo/core/events/MongoEvents.h"
 #include "robomongo/core/domain/ScriptInfo.h"
 
@@ -10,11 +11,30 @@ namespace Robomongo
         Q_OBJECT
 
     public:
-        MongoShell(MongoServer *server,const ScriptInfo &scriptInfo);
+        /**
+         * @param server: server, that can be shared with other shells.
+         * @param defaultDatabase: database, selected in the scope of the shell when it is created.
+         */
+        MongoShell(MongoServer *server,const ScriptInfo &scriptInfo, const std::string &defaultDatabase = std::string());
 
         void open(const std::string &script, const std::string &dbName = std::string());
         void query(int resultIndex, const MongoQueryInfo &info);
+
+        /**
+         * @brief Close server-side cursors, kept open for paging of query results,
+         * and cancel loading of results.
+         */
+        void releaseCursors();
+
+        /**
+         * @brief Frees resources, kept for this shell by shared server (script scope and cursors).
+         */
+        void close();
         void autocomplete(const std::string &prefix);
+
+        /**
+         * @brief Interrupts executed script and cancels loading of query results.
+         */
         void stop();
         MongoServer *server() const { return _server; }
         std::string query() const;
@@ -33,10 +53,18 @@ namespace Robomongo
         void handle(ExecuteQueryResponse *event);
         void handle(ExecuteScriptResponse *event);
         void handle(AutocompleteResponse *event);
+        void handle(OperationProgressEvent *event);
 
     private:        
+        void cancelQueries();
+
         ScriptInfo _scriptInfo;
         MongoServer *_server;
+
+        /**
+         * @brief Tokens of the last query of every result (key is result index).
+         */
+        std::map<int, OperationTokenPtr> _queryTokens;
     };
 
 }
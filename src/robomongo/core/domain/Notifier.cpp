@@ -1,5 +1,6 @@
 #include "robomongo/core/domain/Notifier.h"
 
+#include <set>
 #include <QAction>
 #include <QClipboard>
 #include <QApplication>
@@ -14,7 +15,7 @@
 
 #include "robomongo/shell/db/ptimeutil.h"
 
-#include "robomongo/gui/widgets/workarea/BsonTreeItem.h"
+#include "robomongo/gui/widgets/workarea/BsonTreeModel.h"
 #include "robomongo/gui/dialogs/DocumentTextEditor.h"
 #include "robomongo/gui/utils/DialogUtils.h"
 #include "robomongo/gui/GuiRegistry.h"
@@ -24,15 +25,15 @@ namespace Robomongo
 {
     namespace detail
     {
-        bool isSimpleType(Robomongo::BsonTreeItem *item)
+        bool isSimpleType(const Robomongo::BsonTreeItem &item)
         {
-            return Robomongo::BsonUtils::isSimpleType(item->type())
-                || Robomongo::BsonUtils::isUuidType(item->type(), item->binType());
+            return Robomongo::BsonUtils::isSimpleType(item.type())
+                || Robomongo::BsonUtils::isUuidType(item.type(), item.binType());
         }
 
-        bool isObjectIdType(Robomongo::BsonTreeItem *item)
+        bool isObjectIdType(const Robomongo::BsonTreeItem &item)
         {
-            return mongo::jstOID == item->type();
+            return mongo::jstOID == item.type();
         }
 
         bool isMultiSelection(const QModelIndexList &indexes)
@@ -40,9 +41,9 @@ namespace Robomongo
             return indexes.count()>1;
         }
 
-        bool isDocumentType(BsonTreeItem *item)
+        bool isDocumentType(const BsonTreeItem &item)
         {
-            return Robomongo::BsonUtils::isDocument(item->type());
+            return Robomongo::BsonUtils::isDocument(item.type());
         }
 
         /**
@@ -53,33 +54,26 @@ namespace Robomongo
          */
         QModelIndexList uniqueRows(QModelIndexList indexes, bool returnSuperParents)
         {
+            // Top level row is row of document both in tree model and in table proxy,
+            // so indexes are not mapped to source (that may load nodes of the model)
             QModelIndexList result;
+            std::set<int> documentRows;
             for (QModelIndexList::const_iterator it = indexes.begin(); it!=indexes.end(); ++it)
             {
                 QModelIndex isUnique = *it;
-                Robomongo::BsonTreeItem *item = Robomongo::QtUtils::item<Robomongo::BsonTreeItem*>(isUnique);
-                if(item){                
-                    for (QModelIndexList::const_iterator jt = result.begin(); jt!=result.end(); ++jt)
-                    {
-                        Robomongo::BsonTreeItem *jItem = Robomongo::QtUtils::item<Robomongo::BsonTreeItem*>(*jt);
-                        if (jItem && jItem->superParent() == item->superParent()){
-                            isUnique = QModelIndex();
-                            break;
-                        }
-                    }
-                    if (isUnique.isValid()){
-                        if (returnSuperParents) {
-                            // Move index onto "super parent" element before pushing it into result set
-                            QModelIndex parent = isUnique.parent();
-                            while (parent != QModelIndex()) {
-                                isUnique = parent;
-                                parent = parent.parent();
-                            }
-                        }
-                        result.append(isUnique);
-                    }
-                }
-            }        
+                if (!isUnique.isValid())
+                    continue;
+
+                QModelIndex superParent = isUnique;
+                while (superParent.parent().isValid())
+                    superParent = superParent.parent();
+
+                if (!documentRows.insert(superParent.row()).second)
+                    continue;
+
+                // Move index onto "super parent" element before pushing it into result set
+                result.append(returnSuperParents ? superParent : isUnique);
+            }
             return result;
         }
     }
@@ -92,6 +86,7 @@ namespace Robomongo
     {
         QWidget *wid = dynamic_cast<QWidget*>(_observer);
         AppRegistry::instance().bus()->subscribe(this, InsertDocumentResponse::Type);
+        AppRegistry::instance().bus()->subscribe(this, UpdateDocumentResponse::Type);
 
         _deleteDocumentAction = new QAction("Delete Document...", wid);
         VERIFY(connect(_deleteDocumentAction, SIGNAL(triggered()), SLOT(onDeleteDocument())));
@@ -118,16 +113,16 @@ namespace Robomongo
         VERIFY(connect(_copyJsonAction, SIGNAL(triggered()), SLOT(onCopyJson())));        
     }
 
-    void Notifier::initMenu(QMenu *const menu, BsonTreeItem *const item)
+    void Notifier::initMenu(QMenu *const menu, const BsonTreeItem &item)
     {
         bool isEditable = _queryInfo._info.isValid();
-        bool onItem = item ? true : false;
+        bool onItem = !item.isNull();
         
         bool isSimple = false;
         bool isDocument = false;
         bool isObjectId = false;
 
-        if (item) {
+        if (onItem) {
             isSimple = detail::isSimpleType(item);
             isDocument = detail::isDocumentType(item);
             isObjectId = detail::isObjectIdType(item);
@@ -154,15 +149,16 @@ namespace Robomongo
         if (isEditable) menu->addAction(_deleteDocumentsAction);
     }
 
-    void Notifier::deleteDocuments(std::vector<BsonTreeItem*> items, bool force)
+    void Notifier::deleteDocuments(const std::vector<BsonTreeItem> &items, bool force)
     {
-        bool isNeededRefresh = false;
-        for (std::vector<BsonTreeItem*>::const_iterator it = items.begin(); it != items.end(); ++it) {
-            BsonTreeItem * documentItem = *it;
-            if (!documentItem)
+        std::vector<mongo::BSONObj> ids;
+        ids.reserve(items.size());
+        for (std::vector<BsonTreeItem>::const_iterator it = items.begin(); it != items.end(); ++it) {
+            const BsonTreeItem &documentItem = *it;
+            if (documentItem.isNull())
                 break;
 
-            mongo::BSONObj obj = documentItem->superRoot();
+            mongo::BSONObj obj = documentItem.superRoot();
             mongo::BSONElement id = obj.getField("_id");
 
             if (id.eoo()) {
@@ -171,11 +167,6 @@ namespace Robomongo
                 break;
             }
 
-            mongo::BSONObjBuilder builder;
-            builder.append(id);
-            mongo::BSONObj bsonQuery = builder.obj();
-            mongo::Query query(bsonQuery);
-
             if (!force) {
                 // Ask user
                 int answer = utils::questionDialog(dynamic_cast<QWidget*>(_observer), "Delete",
@@ -185,12 +176,11 @@ namespace Robomongo
                     break;
             }
 
-            isNeededRefresh=true;
-            _shell->server()->removeDocuments(query, _queryInfo._info._ns);
+            ids.push_back(id.wrap());
         }
 
-        if (isNeededRefresh)
-            _shell->query(0, _queryInfo);
+        // All documents are removed with single request, result views are patched by response
+        _shell->server()->removeDocuments(ids, _queryInfo._info._ns);
     }
 
     void Notifier::handle(InsertDocumentResponse *event)
@@ -198,6 +188,18 @@ namespace Robomongo
         _shell->query(0, _queryInfo);
     }
 
+    void Notifier::handle(UpdateDocumentResponse *event)
+    {
+        // Result view itself is patched (or refreshed) by OutputItemContentWidget
+        if (!event->isError() || event->ns().toString() != _queryInfo._info._ns.toString())
+            return;
+
+        QWidget *widget = dynamic_cast<QWidget*>(_observer);
+        if (widget && widget->isVisible()) {
+            QMessageBox::warning(widget, "Document is not saved", QtUtils::toQString(event->error().errorMessage()));
+        }
+    }
+
     void Notifier::onDeleteDocuments()
     {
         if (!_queryInfo._info.isValid())
@@ -208,9 +210,9 @@ namespace Robomongo
             return;
         int answer = QMessageBox::question(dynamic_cast<QWidget*>(_observer), "Delete", QString("Do you want to delete %1 selected documents?").arg(selectedIndexes.count()));
         if (answer == QMessageBox::Yes) {
-            std::vector<BsonTreeItem*> items;
+            std::vector<BsonTreeItem> items;
             for (QModelIndexList::const_iterator it = selectedIndexes.begin(); it!= selectedIndexes.end(); ++it) {
-                BsonTreeItem *item = QtUtils::item<BsonTreeItem*>(*it);
+                BsonTreeItem item = BsonTreeModel::item(*it);
                 items.push_back(item);                
             }
             deleteDocuments(items,true);
@@ -226,8 +228,8 @@ namespace Robomongo
         if (!selectedIndex.isValid())
             return;
 
-        BsonTreeItem *documentItem = QtUtils::item<BsonTreeItem*>(selectedIndex);
-        std::vector<BsonTreeItem*> vec;
+        BsonTreeItem documentItem = BsonTreeModel::item(selectedIndex);
+        std::vector<BsonTreeItem> vec;
         vec.push_back(documentItem);
         return deleteDocuments(vec,false);
     }
@@ -241,11 +243,11 @@ namespace Robomongo
         if (!selectedInd.isValid())
             return;
 
-        BsonTreeItem *documentItem = QtUtils::item<BsonTreeItem*>(selectedInd);
-        if (!documentItem)
+        BsonTreeItem documentItem = BsonTreeModel::item(selectedInd);
+        if (documentItem.isNull())
             return;
 
-        mongo::BSONObj obj = documentItem->superRoot();
+        mongo::BSONObj obj = documentItem.superRoot();
 
         std::string str = BsonUtils::jsonString(obj, mongo::TenGen, 1,
             AppRegistry::instance().settingsManager()->uuidEncoding(),
@@ -259,8 +261,15 @@ namespace Robomongo
         editor.setWindowTitle("Edit Document");
         int result = editor.exec();
 
-        if (result == QDialog::Accepted) {
-            _shell->server()->saveDocuments(editor.bsonObj(), _queryInfo._info._ns);
+        if (result != QDialog::Accepted)
+            return;
+
+        DocumentTextEditor::ReturnType edited = editor.bsonObj();
+        if (edited.size() == 1) {
+            bool checkConflicts = AppRegistry::instance().settingsManager()->checkEditConflicts();
+            _shell->server()->updateDocument(obj, edited[0], _queryInfo._info._ns, checkConflicts);
+        } else {
+            _shell->server()->saveDocuments(edited, _queryInfo._info._ns);
         }
     }
 
@@ -270,11 +279,11 @@ namespace Robomongo
         if (!selectedIndex.isValid())
             return;
 
-        BsonTreeItem *documentItem = QtUtils::item<BsonTreeItem*>(selectedIndex);
-        if (!documentItem)
+        BsonTreeItem documentItem = BsonTreeModel::item(selectedIndex);
+        if (documentItem.isNull())
             return;
 
-        mongo::BSONObj obj = documentItem->superRoot();
+        mongo::BSONObj obj = documentItem.superRoot();
 
         std::string str = BsonUtils::jsonString(obj, mongo::TenGen, 1,
             AppRegistry::instance().settingsManager()->uuidEncoding(),
@@ -304,12 +313,7 @@ namespace Robomongo
         if (result != QDialog::Accepted)
             return;
 
-        DocumentTextEditor::ReturnType obj = editor.bsonObj();
-        for (DocumentTextEditor::ReturnType::const_iterator it = obj.begin(); it != obj.end(); ++it) {
-            _shell->server()->insertDocument(*it, _queryInfo._info._ns);
-        }
-
-        _shell->query(0, _queryInfo);
+        _shell->server()->insertDocuments(editor.bsonObj(), _queryInfo._info._ns);
     }
 
     void Notifier::onCopyDocument()
@@ -318,15 +322,15 @@ namespace Robomongo
         if (!selectedInd.isValid())
             return;
 
-        BsonTreeItem *documentItem = QtUtils::item<BsonTreeItem*>(selectedInd);
-        if (!documentItem)
+        BsonTreeItem documentItem = BsonTreeModel::item(selectedInd);
+        if (documentItem.isNull())
             return;
 
         if (!detail::isSimpleType(documentItem))
             return;
 
         QClipboard *clipboard = QApplication::clipboard();
-        clipboard->setText(documentItem->value());
+        clipboard->setText(documentItem.value());
     }
 
     void Notifier::onCopyTimestamp()
@@ -335,8 +339,8 @@ namespace Robomongo
         if (!selectedInd.isValid())
             return;
 
-        BsonTreeItem *documentItem = QtUtils::item<BsonTreeItem*>(selectedInd);
-        if (!documentItem)
+        BsonTreeItem documentItem = BsonTreeModel::item(selectedInd);
+        if (documentItem.isNull())
             return;
 
         if (!detail::isObjectIdType(documentItem))
@@ -345,7 +349,7 @@ namespace Robomongo
         QClipboard *clipboard = QApplication::clipboard();
 
         // new Date(parseInt(this.valueOf().slice(0,8), 16)*1000);
-        QString hexTimestamp = documentItem->value().mid(10,8);
+        QString hexTimestamp = documentItem.value().mid(10,8);
         bool ok;
         long long milliTimestamp = (long long)hexTimestamp.toLongLong(&ok,16)*1000;
 
@@ -371,19 +375,16 @@ namespace Robomongo
          if (!selectedInd.isValid())
              return;
 
-         BsonTreeItem *documentItem = QtUtils::item<BsonTreeItem*>(selectedInd);
-         if (!documentItem)
+         BsonTreeItem documentItem = BsonTreeModel::item(selectedInd);
+         if (documentItem.isNull())
              return;
 
          if (!detail::isDocumentType(documentItem))
              return;
 
          QClipboard *clipboard = QApplication::clipboard();
-         mongo::BSONObj obj = documentItem->root();
-         if (documentItem != documentItem->superParent()){
-             obj = obj[QtUtils::toStdString(documentItem->key())].Obj();
-         }
-         bool isArray = BsonUtils::isArray(documentItem->type());
+         mongo::BSONObj obj = documentItem.obj();
+         bool isArray = BsonUtils::isArray(documentItem.type());
          std::string str = BsonUtils::jsonString(obj, mongo::TenGen, 1,
                  AppRegistry::instance().settingsManager()->uuidEncoding(),
                  AppRegistry::instance().settingsManager()->timeZone(),isArray);
@@ -14,13 +14,14 @@ namespace Robomongo
     class MongoShell;
     class BsonTreeItem;
     class InsertDocumentResponse;
+    class UpdateDocumentResponse;
 
     namespace detail
     {
-        bool isSimpleType(BsonTreeItem *item);
-        bool isObjectIdType(BsonTreeItem *item);
+        bool isSimpleType(const BsonTreeItem &item);
+        bool isObjectIdType(const BsonTreeItem &item);
         bool isMultiSelection(const QModelIndexList &indexes);
-        bool isDocumentType(BsonTreeItem *item);
+        bool isDocumentType(const BsonTreeItem &item);
         QModelIndexList uniqueRows(QModelIndexList indexes, bool returnSuperParents = false);
     }
 
@@ -41,10 +42,10 @@ namespace Robomongo
     public:
         typedef QObject BaseClass;
         Notifier(INotifierObserver *const observer, MongoShell *shell, const MongoQueryInfo &queryInfo, QObject *parent = NULL);
-        void initMenu(QMenu *const menu, BsonTreeItem *const item);
+        void initMenu(QMenu *const menu, const BsonTreeItem &item);
         void initMultiSelectionMenu(QMenu *const menu);
 
-        void deleteDocuments(std::vector<BsonTreeItem*> items, bool force);
+        void deleteDocuments(const std::vector<BsonTreeItem> &items, bool force);
 
     public Q_SLOTS: 
         void onDeleteDocument();
@@ -56,6 +57,7 @@ namespace Robomongo
         void onCopyTimestamp();
         void onCopyJson();
         void handle(InsertDocumentResponse *event);
+        void handle(UpdateDocumentResponse *event);
 
     private:
         QAction *_deleteDocumentAction;
@@ -4,14 +4,8 @@
 #include <QDir>
 #include <QStringList>
 #include <QRegExp>
-#include <QTextStream>
-#include <QFile>
 #include <QElapsedTimer>
 
-#include <third_party/js-1.7/jsapi.h>
-#include <third_party/js-1.7/jsparse.h>
-#include <third_party/js-1.7/jsscan.h>
-#include <third_party/js-1.7/jsstr.h>
 #include <mongo/util/assert_util.h>
 #include <mongo/scripting/engine.h>
 #include <mongo/scripting/engine_spidermonkey.h>
@@ -20,10 +14,12 @@
 #include <mongo/client/dbclient.h>
 #include <pcrecpp.h>
 
+#include "robomongo/core/engine/StatementSplitter.h"
 #include "robomongo/core/settings/ConnectionSettings.h"
 #include "robomongo/core/settings/CredentialSettings.h"
 #include "robomongo/core/domain/MongoDocument.h"
 #include "robomongo/core/utils/QtUtils.h"
+#include "robomongo/core/utils/Logger.h"
 
 namespace
 {
@@ -40,7 +36,11 @@ namespace
         return output;
     }
 
-    mongo::RecursiveMutex _mutex( "ScriptEngine::_mutex" );
+    /**
+     * @brief Guards process-wide state of the shell: setup of global script engine.
+     * Scripts themselves are executed without this lock, every scope has its own output.
+     */
+    mongo::RecursiveMutex _globalsMutex( "ScriptEngine::_globalsMutex" );
 }
 
 namespace mongo {
@@ -52,22 +52,26 @@ namespace Robomongo
     ScriptEngine::ScriptEngine(ConnectionSettings *connection) :
         _connection(connection),
         _scope(NULL),
-        _engine(NULL) { }
+        _engine(NULL),
+        _isLoadMongoRcJs(false),
+        _batchSize(0) { }
 
     ScriptEngine::~ScriptEngine()
     {
-        mongo::RecursiveMutex::scoped_lock lk( _mutex );
-
-        delete _scope;
+        for (ScopesContainerType::const_iterator it = _scopes.begin(); it != _scopes.end(); ++it) {
+            delete it->second;
+        }
+        _scopes.clear();
         _scope = NULL;
 
-        delete _engine;
+        // Script engine itself is global and shared by engines of all servers,
+        // so it is not deleted here (other servers still create scopes with it)
         _engine = NULL;
     }
 
     void ScriptEngine::init(bool isLoadMongoRcJs)
     {
-        mongo::RecursiveMutex::scoped_lock lk( _mutex );
+        mongo::RecursiveMutex::scoped_lock lk( _globalsMutex );
 
         std::string connectDatabase = "test";
 
@@ -84,49 +88,107 @@ namespace Robomongo
                << _connection->primaryCredential()->userName() << "', '"
                << _connection->primaryCredential()->userPassword() << "')";
 
-        {
-            mongo::shell_utils::_dbConnect = ss.str();
+        _connectScript = ss.str();
+        _isLoadMongoRcJs = isLoadMongoRcJs;
+
+        // Runtime (and shell files, compiled by it) is created once per process
+        if (!mongo::globalScriptEngine) {
+            QElapsedTimer timer;
+            timer.start();
+
             mongo::isShell = true;
 
             mongo::ScriptEngine::setConnectCallback( mongo::shell_utils::onConnect );
             mongo::ScriptEngine::setup();
             mongo::globalScriptEngine->setScopeInitCallback( mongo::shell_utils::initScope );
 
-            mongo::Scope *scope = mongo::globalScriptEngine->newScope();
-            _scope = scope;
-            _engine = mongo::globalScriptEngine;
-
-            // Load '.mongorc.js' from user's home directory
-            // We are not checking whether file exists, because it will be
-            // checked by 'Scope::execFile'.
-            if (isLoadMongoRcJs) {
-                std::string mongorcPath = QtUtils::toStdString(QString("%1/.mongorc.js").arg(QDir::homePath()));
-                scope->execFile(mongorcPath, false, false);      
-            }
-
-            // Load '.robomongorc.js'
-            // Alexander: branding very usfull see Chromium and his brand Chrome, in Chrome some features private
-            // Dmitry: I agree, but we still need to support ".robomongorc.js" even when name of project will change
-            std::string roboMongorcPath = QtUtils::toStdString(QString("%1/.robomongorc.js").arg(QDir::homePath()));
-            scope->execFile(roboMongorcPath, false, false);
+            LOG_MSG(QString("JavaScript engine setup: %1 ms").arg(timer.elapsed()), mongo::LL_INFO);
         }
+        _engine = mongo::globalScriptEngine;
 
-        // Esprima ECMAScript parser: http://esprima.org/
-        QFile file(":/robomongo/scripts/esprima.js");
-        if (!file.open(QIODevice::ReadOnly))
-            throw std::runtime_error("Unable to read esprima.js ");
+        _scope = createScope();
+        _scopes[NULL] = _scope;
+    }
 
-        QTextStream in(&file);
-        QString esprima = in.readAll();
+    mongo::Scope *ScriptEngine::createScope()
+    {
+        QElapsedTimer total;
+        total.start();
+        QElapsedTimer timer;
+        timer.start();
+
+        // Shell files are compiled by the first scope and then only executed
+        mongo::Scope *scope = _engine->newScope();
+        qint64 shellFilesMs = timer.restart();
+
+        // Connection script is executed here rather than by scope init callback
+        // (with global shell_utils::_dbConnect), so scopes of different servers
+        // can be created concurrently
+        uassert( 12513, "connect failed", scope->exec( _connectScript , "(connect)" , false , true , false ) );
+        qint64 connectMs = timer.restart();
+
+        // Load '.mongorc.js' from user's home directory
+        // We are not checking whether file exists, because it will be
+        // checked by 'Scope::execFile'.
+        if (_isLoadMongoRcJs) {
+            std::string mongorcPath = QtUtils::toStdString(QString("%1/.mongorc.js").arg(QDir::homePath()));
+            scope->execFile(mongorcPath, false, false);
+        }
+        qint64 mongorcMs = timer.restart();
 
-        // Inject Esprima into Javascript scope
-        _scope->exec(QtUtils::toStdString(esprima), "(esprima)", true, true, true);
+        // Load '.robomongorc.js'
+        // Alexander: branding very usfull see Chromium and his brand Chrome, in Chrome some features private
+        // Dmitry: I agree, but we still need to support ".robomongorc.js" even when name of project will change
+        std::string roboMongorcPath = QtUtils::toStdString(QString("%1/.robomongorc.js").arg(QDir::homePath()));
+        scope->execFile(roboMongorcPath, false, false);
+        qint64 roboMongorcMs = timer.restart();
 
         // Enable verbose shell reporting
-        _scope->exec("_verboseShell = true;", "(verboseShell)", false, false, false);
+        scope->exec("_verboseShell = true;", "(verboseShell)", false, false, false);
 
         // Save original autocomplete function so it can be restored if overwritten by user preference
-        _scope->exec("DB.autocompleteOriginal = DB.autocomplete;", "(saveOriginalAutocomplete)", false, false, false);
+        scope->exec("DB.autocompleteOriginal = DB.autocomplete;", "(saveOriginalAutocomplete)", false, false, false);
+
+        if (_batchSize > 0) {
+            char buff[64]={0};
+            sprintf(buff,"DBQuery.shellBatchSize = %d",_batchSize);
+            scope->exec(buff, "(shellBatchSize)", true, true, true);
+        }
+
+        LOG_MSG(QString("Shell scope created in %1 ms (shell files: %2 ms, connect: %3 ms, .mongorc.js: %4 ms, .robomongorc.js: %5 ms)")
+                .arg(total.elapsed()).arg(shellFilesMs).arg(connectMs).arg(mongorcMs).arg(roboMongorcMs), mongo::LL_INFO);
+
+        return scope;
+    }
+
+    void ScriptEngine::switchScope(QObject *shell, const std::string &defaultDatabase)
+    {
+        ScopesContainerType::const_iterator it = _scopes.find(shell);
+        if (it != _scopes.end()) {
+            _scope = it->second;
+            return;
+        }
+
+        _scope = createScope();
+        _scopes[shell] = _scope;
+        use(defaultDatabase);
+    }
+
+    void ScriptEngine::releaseScope(QObject *shell)
+    {
+        // Default scope lives as long as engine
+        if (!shell)
+            return;
+
+        ScopesContainerType::iterator it = _scopes.find(shell);
+        if (it == _scopes.end())
+            return;
+
+        if (_scope == it->second)
+            _scope = _scopes[NULL];
+
+        delete it->second;
+        _scopes.erase(it);
     }
 
     MongoShellExecResult ScriptEngine::exec(const std::string &originalScript, const std::string &dbName)
@@ -134,8 +196,6 @@ namespace Robomongo
         if(!_scope)
             return MongoShellExecResult();
 
-        mongo::RecursiveMutex::scoped_lock lk( _mutex );
-
         /*
          * Replace all commands ('show dbs', 'use db' etc.) with call
          * to shellHelper('show', 'dbs') and so on.
@@ -152,11 +212,19 @@ namespace Robomongo
          * execute each statement one by one
          */
         std::vector<std::string> statements;
+        std::vector<int> lines;
         std::string error;
-        bool result = statementize(stdstr, statements, error);
+        bool isValid = StatementSplitter::split(stdstr, statements, lines, error);
+
+        // Nothing is executed, if any statement has syntax error
+        for (size_t i = 0; isValid && i < statements.size(); ++i) {
+            isValid = _scope->compile(statements[i], "(shell)", lines[i], error);
+        }
 
-        if (!result && statements.size() == 0) {
-            statements.push_back("print(__robomongoResult.error)");
+        if (!isValid) {
+            statements.clear();
+            _scope->setString("__robomongoSyntaxError", error.c_str());
+            statements.push_back("print(__robomongoSyntaxError)");
         }
 
         std::vector<MongoShellResult> results;
@@ -166,11 +234,8 @@ namespace Robomongo
         for(std::vector<std::string>::const_iterator it = statements.begin(); it != statements.end(); ++it)
         {
             std::string statement = *it;
-            // clear global objects
-            __objects.clear();
-            __type = "";
-            __finished = false;
-            __logs.str("");
+            mongo::Scope::ShellOutput &output = _scope->shellOutput();
+            output.reset();
 
             if (true /* ! wascmd */) {
                 try {
@@ -181,10 +246,9 @@ namespace Robomongo
 
                     qint64 elapsed = timer.elapsed();
 
-                    std::string logs = __logs.str();
-                    std::string answer = logs.c_str();
-                    std::string type = __type.c_str();
-                    std::vector<MongoDocumentPtr> docs = MongoDocument::fromBsonObj(__objects);
+                    std::string answer = output.logs.str();
+                    std::string type = output.type;
+                    std::vector<MongoDocumentPtr> docs = MongoDocument::fromBsonObj(output.objects);
 
                     if (!answer.empty() || docs.size() > 0)
                         results.push_back(prepareResult(type, answer, docs, elapsed));
@@ -205,8 +269,6 @@ namespace Robomongo
 
     void ScriptEngine::use(const std::string &dbName)
     {
-        mongo::RecursiveMutex::scoped_lock lk( _mutex );
-
         if (!dbName.empty()) {
             // switch to database
             char useDb[1024]={0};
@@ -217,17 +279,22 @@ namespace Robomongo
 
     void ScriptEngine::setBatchSize(int batchSize)
     {
-        mongo::RecursiveMutex::scoped_lock lk( _mutex );
+        _batchSize = batchSize;
+
         char buff[64]={0};
         sprintf(buff,"DBQuery.shellBatchSize = %d",batchSize);
 
-        _scope->exec(buff, "(shellBatchSize)", true, true, true);
+        for (ScopesContainerType::const_iterator it = _scopes.begin(); it != _scopes.end(); ++it) {
+            it->second->exec(buff, "(shellBatchSize)", true, true, true);
+        }
     }
 
     void ScriptEngine::ping()
     {
-        mongo::RecursiveMutex::scoped_lock lk( _mutex );
-        _scope->exec("if (db) { db.runCommand({ping:1}); }", "(ping)", false, false, false);
+        // Every scope has its own connection of 'db' object
+        for (ScopesContainerType::const_iterator it = _scopes.begin(); it != _scopes.end(); ++it) {
+            it->second->exec("if (db) { db.runCommand({ping:1}); }", "(ping)", false, false, false);
+        }
     }
 
     QStringList ScriptEngine::complete(const std::string &prefix, const AutocompletionMode mode)
@@ -340,52 +407,4 @@ namespace Robomongo
     {
         return _scope->getString(fieldName);
     }
-
-    bool ScriptEngine::statementize(const std::string &script, std::vector<std::string> &outList, std::string &outError)
-    {
-        QString qScript = QtUtils::toQString(script);
-        _scope->setString("__robomongoEsprima", script.c_str());
-
-        mongo::StringData data(
-            "var __robomongoResult = {};"
-            "try {"
-                "__robomongoResult.result = esprima.parse(__robomongoEsprima, { range: true, loc : true });"
-            "} catch(e) {"
-                "__robomongoResult.error = e.name + ': ' + e.message;"
-            "}"
-            "__robomongoResult;"
-        );
-
-        bool res2 = _scope->exec(data, "(esprima2)", false, true, false);
-        mongo::BSONObj obj = _scope->getObject("__lastres__");
-
-        if (obj.hasField("error")) {
-            outError = obj.getField("error");
-            return false;
-        }
-
-        mongo::BSONObj result = obj.getField("result").Obj();
-        std::vector<mongo::BSONElement> v = result.getField("body").Array();
-        for (std::vector<mongo::BSONElement>::iterator it = v.begin(); it != v.end(); ++it)
-        {
-            mongo::BSONObj item = (*it).Obj();
-            mongo::BSONObj loc = item.getField("loc").Obj();
-            mongo::BSONObj start = loc.getField("start").Obj();
-            mongo::BSONObj end = loc.getField("end").Obj();
-
-            int startLine = start.getIntField("line");
-            int startColumn = start.getIntField("column");
-            int endLine = end.getIntField("line");
-            int endColumn = end.getIntField("column");
-
-            std::vector<mongo::BSONElement> range = item.getField("range").Array();
-            int from = (int) range.at(0).number();
-            int till = (int) range.at(1).number();
-
-            std::string statement = QtUtils::toStdString(qScript.mid(from, till - from));
-            outList.push_back(statement);
-        }
-
-        return true;
-    }
 }
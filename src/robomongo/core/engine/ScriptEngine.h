@@ -1,15 +1,23 @@
 #pragma once
 
+#include <map>
 #include <mongo/scripting/engine.h>
-#include <third_party/js-1.7/jsparse.h>
 
 #include "robomongo/core/domain/MongoShellResult.h"
 #include "robomongo/core/Enums.h"
 
+QT_BEGIN_NAMESPACE
+class QObject;
+QT_END_NAMESPACE
+
 namespace Robomongo
 {
     class ConnectionSettings;
 
+    /**
+     * @brief ScriptEngine is shared by all shells of the server. Every shell
+     * has its own JavaScript scope (variables, current database).
+     */
     class ScriptEngine
     {
 
@@ -18,6 +26,13 @@ namespace Robomongo
         ~ScriptEngine();
 
         void init(bool isLoadMongoJs);
+
+        /**
+         * @brief Makes scope of 'shell' current. Scope is created on first use,
+         * with 'defaultDatabase' selected in it (if it is not empty).
+         */
+        void switchScope(QObject *shell, const std::string &defaultDatabase = std::string());
+        void releaseScope(QObject *shell);
         MongoShellExecResult exec(const std::string &script, const std::string &dbName = std::string());
         void interrupt();
 
@@ -34,11 +49,19 @@ namespace Robomongo
 
         std::string getString(const char *fieldName);
 
-        bool statementize(const std::string &script, std::vector<std::string> &outList, std::string &outError);
-        std::vector<std::string> statementize2(const std::string &script);
-        void parseTree(JSParseNode * root, int indent, const std::string &script, std::vector<std::string> &list, bool topList);
+        mongo::Scope *createScope();
 
         mongo::ScriptEngine *_engine;
         mongo::Scope *_scope;
+
+        /**
+         * @brief Scopes of shells, scope with NULL key is created in init().
+         */
+        typedef std::map<QObject *, mongo::Scope *> ScopesContainerType;
+        ScopesContainerType _scopes;
+
+        std::string _connectScript;
+        bool _isLoadMongoRcJs;
+        int _batchSize;
     };
 }
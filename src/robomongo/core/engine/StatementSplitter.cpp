@@ -0,0 +1,687 @@
+#include "robomongo/core/engine/StatementSplitter.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <sstream>
+
+namespace
+{
+    enum TokenType
+    {
+        EndToken,
+        PunctuatorToken,
+        IdentifierToken,
+        NumberToken,
+        StringToken,
+        RegexToken
+    };
+
+    struct Token
+    {
+        Token() :
+            type(EndToken),
+            begin(0),
+            end(0),
+            newlineBefore(false) { }
+
+        bool is(const char *value) const
+        {
+            return (type == PunctuatorToken || type == IdentifierToken) && text == value;
+        }
+
+        TokenType type;
+        size_t begin;
+        size_t end;
+
+        /**
+         * @brief Line terminator (possibly inside of comment) precedes this token.
+         */
+        bool newlineBefore;
+
+        /**
+         * @brief Text of punctuator or identifier (empty for other tokens).
+         */
+        std::string text;
+    };
+
+    struct SyntaxError
+    {
+        SyntaxError(size_t position, const std::string &message) :
+            position(position),
+            message(message) { }
+
+        size_t position;
+        std::string message;
+    };
+
+    const char *illegalToken = "Unexpected token ILLEGAL";
+
+    /**
+     * @brief Multi-character punctuators, longest first.
+     */
+    const char *punctuators[] = {
+        ">>>=", "===", "!==", "<<=", ">>=", ">>>",
+        "&&", "||", "==", "!=", "<=", ">=", "++", "--", "+=", "-=",
+        "*=", "/=", "%=", "&=", "|=", "^=", "<<", ">>",
+        NULL
+    };
+
+    const char *singlePunctuators = "{}()[];,.<>+-*/%&|^!~?:=";
+
+    class Lexer
+    {
+    public:
+        explicit Lexer(const std::string &script) :
+            _script(script),
+            _pos(0) { }
+
+        Token next(bool regexAllowed)
+        {
+            Token token;
+            token.newlineBefore = skipWhitespaceAndComments();
+            token.begin = _pos;
+
+            if (_pos >= _script.size()) {
+                token.end = _pos;
+                return token;
+            }
+
+            unsigned char ch = at(_pos);
+            if (ch == '\'' || ch == '"') {
+                token.type = StringToken;
+                readString(ch);
+            } else if (isdigit(ch) || (ch == '.' && isdigit(at(_pos + 1)))) {
+                token.type = NumberToken;
+                readNumber();
+            } else if (isIdentifierPart(_pos)) {
+                token.type = IdentifierToken;
+                while (_pos < _script.size() && isIdentifierPart(_pos))
+                    ++_pos;
+                token.text = _script.substr(token.begin, _pos - token.begin);
+            } else if (ch == '/' && regexAllowed) {
+                token.type = RegexToken;
+                readRegex();
+            } else {
+                token.type = PunctuatorToken;
+                token.text = readPunctuator();
+            }
+
+            token.end = _pos;
+            return token;
+        }
+
+    private:
+        unsigned char at(size_t pos) const
+        {
+            return pos < _script.size() ? static_cast<unsigned char>(_script[pos]) : 0;
+        }
+
+        /**
+         * @returns length of line terminator at 'pos' (LF, CR, CRLF, U+2028 or U+2029
+         * in UTF-8), or 0 if there is no line terminator.
+         */
+        size_t lineTerminatorLength(size_t pos) const
+        {
+            unsigned char ch = at(pos);
+            if (ch == '\n')
+                return 1;
+            if (ch == '\r')
+                return at(pos + 1) == '\n' ? 2 : 1;
+            if (ch == 0xE2 && at(pos + 1) == 0x80 && (at(pos + 2) == 0xA8 || at(pos + 2) == 0xA9))
+                return 3;
+            return 0;
+        }
+
+        /**
+         * @returns length of white space at 'pos' (including NBSP and BOM in UTF-8).
+         */
+        size_t whitespaceLength(size_t pos) const
+        {
+            unsigned char ch = at(pos);
+            if (ch == ' ' || ch == '\t' || ch == '\v' || ch == '\f')
+                return 1;
+            if (ch == 0xC2 && at(pos + 1) == 0xA0)
+                return 2;
+            if (ch == 0xEF && at(pos + 1) == 0xBB && at(pos + 2) == 0xBF)
+                return 3;
+            return 0;
+        }
+
+        /**
+         * @brief Non-ASCII characters (except of white space and line terminators)
+         * are treated as identifier characters, like backslash of unicode escape.
+         */
+        bool isIdentifierPart(size_t pos) const
+        {
+            unsigned char ch = at(pos);
+            if (isalnum(ch) || ch == '_' || ch == '$' || ch == '\\')
+                return true;
+            return ch >= 0x80 && !lineTerminatorLength(pos) && !whitespaceLength(pos);
+        }
+
+        /**
+         * @returns true, if line terminator was skipped.
+         */
+        bool skipWhitespaceAndComments()
+        {
+            bool newline = false;
+            while (_pos < _script.size()) {
+                if (size_t length = lineTerminatorLength(_pos)) {
+                    newline = true;
+                    _pos += length;
+                } else if (size_t length = whitespaceLength(_pos)) {
+                    _pos += length;
+                } else if (at(_pos) == '/' && at(_pos + 1) == '/') {
+                    while (_pos < _script.size() && !lineTerminatorLength(_pos))
+                        ++_pos;
+                } else if (at(_pos) == '/' && at(_pos + 1) == '*') {
+                    size_t end = _script.find("*/", _pos + 2);
+                    if (end == std::string::npos)
+                        throw SyntaxError(_script.size(), illegalToken);
+
+                    for (; _pos < end; ++_pos) {
+                        if (lineTerminatorLength(_pos))
+                            newline = true;
+                    }
+                    _pos = end + 2;
+                } else {
+                    break;
+                }
+            }
+            return newline;
+        }
+
+        void readString(unsigned char quote)
+        {
+            ++_pos;
+            for (;;) {
+                if (_pos >= _script.size() || lineTerminatorLength(_pos))
+                    throw SyntaxError(_pos, illegalToken);
+
+                unsigned char ch = at(_pos);
+                if (ch == '\\') {
+                    // Escaped character or line continuation
+                    size_t length = lineTerminatorLength(_pos + 1);
+                    _pos += 1 + (length ? length : 1);
+                } else {
+                    ++_pos;
+                    if (ch == quote)
+                        return;
+                }
+            }
+        }
+
+        void readNumber()
+        {
+            bool hex = at(_pos) == '0' && (at(_pos + 1) == 'x' || at(_pos + 1) == 'X');
+            while (_pos < _script.size()) {
+                unsigned char ch = at(_pos);
+                unsigned char prev = _pos ? at(_pos - 1) : 0;
+                if (isalnum(ch) || ch == '.' || ch == '_' || ch == '$') {
+                    ++_pos;
+                } else if (!hex && (ch == '+' || ch == '-') && (prev == 'e' || prev == 'E')) {
+                    ++_pos;
+                } else {
+                    break;
+                }
+            }
+        }
+
+        void readRegex()
+        {
+            ++_pos;
+            bool inClass = false;
+            for (;;) {
+                if (_pos >= _script.size() || lineTerminatorLength(_pos))
+                    throw SyntaxError(_pos, "Invalid regular expression: missing /");
+
+                unsigned char ch = at(_pos);
+                if (ch == '\\') {
+                    ++_pos;
+                    if (_pos >= _script.size() || lineTerminatorLength(_pos))
+                        throw SyntaxError(_pos, "Invalid regular expression: missing /");
+                } else if (ch == '[') {
+                    inClass = true;
+                } else if (ch == ']') {
+                    inClass = false;
+                } else if (ch == '/' && !inClass) {
+                    ++_pos;
+                    break;
+                }
+                ++_pos;
+            }
+
+            // Flags
+            while (_pos < _script.size() && isIdentifierPart(_pos))
+                ++_pos;
+        }
+
+        std::string readPunctuator()
+        {
+            for (const char **punctuator = punctuators; *punctuator; ++punctuator) {
+                size_t length = strlen(*punctuator);
+                if (_script.compare(_pos, length, *punctuator) == 0) {
+                    _pos += length;
+                    return *punctuator;
+                }
+            }
+
+            char ch = _script[_pos];
+            if (!strchr(singlePunctuators, ch))
+                throw SyntaxError(_pos, illegalToken);
+
+            ++_pos;
+            return std::string(1, ch);
+        }
+
+        const std::string &_script;
+        size_t _pos;
+    };
+
+    /**
+     * @brief Kind of parenthesized group, that follows keyword.
+     */
+    enum HeaderKind
+    {
+        NoHeader,
+        ControlHeader,          // if, for, while, with, switch, catch
+        FunctionHeader,         // parameters of function expression
+        FunctionDeclHeader,     // parameters of function declaration
+        DoWhileHeader           // condition of do-while statement
+    };
+
+    struct Bracket
+    {
+        Bracket(char type, HeaderKind header = NoHeader, bool isBlock = false) :
+            type(type),
+            header(header),
+            isBlock(isBlock) { }
+
+        char type;
+        HeaderKind header;
+
+        /**
+         * @brief '{' of block statement or function declaration body
+         * (i.e. not of object literal or function expression).
+         */
+        bool isBlock;
+    };
+
+    /**
+     * @brief Splits program into top-level statements. Only brackets, keywords of
+     * compound statements and tokens around line terminators are examined (this is
+     * enough to apply automatic semicolon insertion rules at top level).
+     */
+    class Splitter
+    {
+    public:
+        Splitter(const std::string &script, std::vector<std::string> &outList, std::vector<size_t> &outOffsets) :
+            _script(script),
+            _lexer(script),
+            _outList(outList),
+            _outOffsets(outOffsets),
+            _lastParenHeader(NoHeader),
+            _lastBraceIsBlock(false),
+            _hasRegex(false),
+            _hasFunction(false),
+            _hasStatement(false),
+            _statementBegin(0),
+            _statementEnd(0),
+            _expectHeader(NoHeader),
+            _awaitingBody(false),
+            _bodyIsBlock(false),
+            _doCount(0),
+            _pendingEnd(NoEnd) { }
+
+        void split()
+        {
+            for (;;) {
+                Token token = _lexer.next(isRegexAllowed());
+
+                if (_pendingEnd != NoEnd) {
+                    if (isCompoundContinuation(token)) {
+                        _pendingEnd = NoEnd;
+                    } else if (_pendingEnd == DoWhileEnd && token.is(";")) {
+                        // Optional semicolon after do-while belongs to statement
+                        _statementEnd = token.end;
+                        _prev = token;
+                        endStatement();
+                        continue;
+                    } else {
+                        endStatement();
+                    }
+                }
+
+                if (token.type == EndToken)
+                    break;
+
+                if (token.type == RegexToken)
+                    _hasRegex = true;
+                else if (token.type == IdentifierToken && token.text == "function")
+                    _hasFunction = true;
+
+                if (_brackets.empty() && _hasStatement && token.newlineBefore && isAutomaticSemicolon(token))
+                    endStatement();
+
+                process(token);
+            }
+
+            if (!_brackets.empty() || _awaitingBody || _expectHeader != NoHeader || _doCount > 0)
+                throw SyntaxError(_script.size(), "Unexpected end of input");
+
+            if (_hasStatement)
+                endStatement();
+        }
+
+        bool hasRegex() const { return _hasRegex; }
+        bool hasFunction() const { return _hasFunction; }
+
+    private:
+        enum PendingEnd
+        {
+            NoEnd,
+            BlockEnd,       // after top-level ';' or '}' of block: ends, unless followed by 'else', 'catch' or 'finally'
+            DoWhileEnd      // after condition of do-while: ends, optional ';' is included
+        };
+
+        static bool isCompoundContinuation(const Token &token)
+        {
+            return token.type == IdentifierToken &&
+                (token.text == "else" || token.text == "catch" || token.text == "finally");
+        }
+
+        /**
+         * @brief Tokens, that continue previous line (automatic semicolon is not inserted before them).
+         */
+        static bool isContinuation(const Token &token)
+        {
+            if (token.type == PunctuatorToken) {
+                return !(token.is("{") || token.is("}") || token.is(";") ||
+                         token.is("++") || token.is("--") || token.is("!") || token.is("~"));
+            }
+
+            return token.is("in") || token.is("instanceof") || isCompoundContinuation(token);
+        }
+
+        /**
+         * @brief Tokens, after which statement may end.
+         */
+        static bool canEndStatement(const Token &token)
+        {
+            static const char *nonTerminal[] = {
+                "var", "new", "typeof", "instanceof", "in", "delete", "void", "throw", "case",
+                "do", "else", "try", "finally", "function", "if", "for", "while", "with", "switch", "catch",
+                NULL
+            };
+
+            switch (token.type) {
+            case NumberToken:
+            case StringToken:
+            case RegexToken:
+                return true;
+            case IdentifierToken:
+                for (const char **keyword = nonTerminal; *keyword; ++keyword) {
+                    if (token.text == *keyword)
+                        return false;
+                }
+                return true;
+            case PunctuatorToken:
+                return token.is(")") || token.is("]") || token.is("}") || token.is("++") || token.is("--");
+            default:
+                return false;
+            }
+        }
+
+        bool isAutomaticSemicolon(const Token &token) const
+        {
+            return !_awaitingBody && _expectHeader == NoHeader && _doCount == 0 &&
+                canEndStatement(_prev) && !isContinuation(token);
+        }
+
+        /**
+         * @brief Slash is regular expression, unless previous token ends an operand.
+         */
+        bool isRegexAllowed() const
+        {
+            static const char *operatorKeywords[] = {
+                "return", "typeof", "instanceof", "in", "new", "delete", "void", "throw", "case", "do", "else",
+                NULL
+            };
+
+            switch (_prev.type) {
+            case EndToken:
+                return true;
+            case IdentifierToken:
+                for (const char **keyword = operatorKeywords; *keyword; ++keyword) {
+                    if (_prev.text == *keyword)
+                        return true;
+                }
+                return false;
+            case PunctuatorToken:
+                if (_prev.is(")"))
+                    return _lastParenHeader == ControlHeader || _lastParenHeader == DoWhileHeader;
+                if (_prev.is("}"))
+                    return _lastBraceIsBlock;
+                return !(_prev.is("]") || _prev.is("++") || _prev.is("--"));
+            default:
+                return false;
+            }
+        }
+
+        void process(const Token &token)
+        {
+            bool statementStart = !_hasStatement;
+            if (statementStart) {
+                _hasStatement = true;
+                _statementBegin = token.begin;
+            }
+            _statementEnd = token.end;
+
+            bool top = _brackets.empty();
+            bool wasAwaitingBody = _awaitingBody;
+            HeaderKind expectedHeader = _expectHeader;
+            bool propertyName = _prev.is(".");
+            _awaitingBody = false;
+            _expectHeader = NoHeader;
+
+            if (token.type == PunctuatorToken) {
+                if (token.is("(")) {
+                    _brackets.push_back(Bracket('(', expectedHeader));
+                } else if (token.is("[")) {
+                    _brackets.push_back(Bracket('['));
+                } else if (token.is("{")) {
+                    bool isBlock = top ? statementStart || (wasAwaitingBody && _bodyIsBlock) : isNestedBlockStart();
+                    _brackets.push_back(Bracket('{', NoHeader, isBlock));
+                } else if (token.is(")") || token.is("]") || token.is("}")) {
+                    close(token);
+                } else if (token.is(";")) {
+                    if (top && _doCount == 0)
+                        _pendingEnd = BlockEnd;
+                }
+            } else if (token.type == IdentifierToken && !propertyName) {
+                const std::string &word = token.text;
+                if (word == "if" || word == "for" || word == "with" || word == "switch" || word == "catch") {
+                    _expectHeader = ControlHeader;
+                } else if (word == "while") {
+                    bool doWhile = top && _doCount > 0 && !_prev.is("do");
+                    if (doWhile)
+                        --_doCount;
+                    _expectHeader = doWhile ? DoWhileHeader : ControlHeader;
+                } else if (word == "function") {
+                    bool declaration = top ? statementStart || wasAwaitingBody : isNestedStatementStart();
+                    _expectHeader = declaration ? FunctionDeclHeader : FunctionHeader;
+                } else if (top && (word == "do" || word == "else" || word == "try" || word == "finally")) {
+                    if (word == "do")
+                        ++_doCount;
+                    _awaitingBody = true;
+                    _bodyIsBlock = true;
+                } else if (expectedHeader == FunctionHeader || expectedHeader == FunctionDeclHeader) {
+                    // Name of function
+                    _expectHeader = expectedHeader;
+                }
+            }
+
+            _prev = token;
+        }
+
+        /**
+         * @brief Token starts statement inside of block or function body
+         * (statements are not tracked below top level, previous token is examined).
+         */
+        bool isNestedStatementStart() const
+        {
+            return _prev.is("{") || _prev.is("}") || _prev.is(";");
+        }
+
+        /**
+         * @brief '{' below top level opens block, unless it follows an operator
+         * or ')' of function expression (then it is object literal or function body).
+         */
+        bool isNestedBlockStart() const
+        {
+            if (_prev.is(")"))
+                return _lastParenHeader != FunctionHeader && _lastParenHeader != NoHeader;
+
+            return isNestedStatementStart() ||
+                _prev.is("else") || _prev.is("do") || _prev.is("try") || _prev.is("finally");
+        }
+
+        void close(const Token &token)
+        {
+            char open = token.is(")") ? '(' : token.is("]") ? '[' : '{';
+            if (_brackets.empty() || _brackets.back().type != open)
+                throw SyntaxError(token.begin, "Unexpected token " + token.text);
+
+            Bracket bracket = _brackets.back();
+            _brackets.pop_back();
+
+            if (open == '(')
+                _lastParenHeader = bracket.header;
+            else if (open == '{')
+                _lastBraceIsBlock = bracket.isBlock;
+
+            if (!_brackets.empty())
+                return;
+
+            switch (bracket.header) {
+            case ControlHeader:
+                _awaitingBody = true;
+                _bodyIsBlock = true;
+                break;
+            case FunctionHeader:
+            case FunctionDeclHeader:
+                _awaitingBody = true;
+                _bodyIsBlock = bracket.header == FunctionDeclHeader;
+                break;
+            case DoWhileHeader:
+                if (_doCount == 0)
+                    _pendingEnd = DoWhileEnd;
+                break;
+            default:
+                if (bracket.isBlock && _doCount == 0)
+                    _pendingEnd = BlockEnd;
+                break;
+            }
+        }
+
+        void endStatement()
+        {
+            _outList.push_back(_script.substr(_statementBegin, _statementEnd - _statementBegin));
+            _outOffsets.push_back(_statementBegin);
+            _hasStatement = false;
+            _expectHeader = NoHeader;
+            _awaitingBody = false;
+            _doCount = 0;
+            _pendingEnd = NoEnd;
+        }
+
+        const std::string &_script;
+        Lexer _lexer;
+        std::vector<std::string> &_outList;
+        std::vector<size_t> &_outOffsets;
+
+        std::vector<Bracket> _brackets;
+        Token _prev;
+        HeaderKind _lastParenHeader;
+        bool _lastBraceIsBlock;
+        bool _hasRegex;
+        bool _hasFunction;
+
+        bool _hasStatement;
+        size_t _statementBegin;
+        size_t _statementEnd;
+
+        HeaderKind _expectHeader;
+        bool _awaitingBody;
+        bool _bodyIsBlock;
+        int _doCount;
+        PendingEnd _pendingEnd;
+    };
+
+    /**
+     * @brief Number of line breaks in [begin, end) of 'script' ("\r\n" is one break).
+     */
+    int countLineBreaks(const std::string &script, size_t begin, size_t end)
+    {
+        int count = 0;
+        end = std::min(end, script.size());
+        for (size_t i = begin; i < end; ++i) {
+            if (script[i] == '\n' || (script[i] == '\r' && (i + 1 >= script.size() || script[i + 1] != '\n')))
+                ++count;
+        }
+        return count;
+    }
+}
+
+namespace Robomongo
+{
+    namespace StatementSplitter
+    {
+        bool split(const std::string &script, std::vector<std::string> &outList, std::string &outError)
+        {
+            std::vector<int> lines;
+            return split(script, outList, lines, outError);
+        }
+
+        bool split(const std::string &script, std::vector<std::string> &outList, std::vector<int> &outLines, std::string &outError)
+        {
+            std::vector<std::string> statements;
+            std::vector<size_t> offsets;
+            try {
+                Splitter splitter(script, statements, offsets);
+                splitter.split();
+            } catch (const SyntaxError &ex) {
+                std::stringstream error;
+                error << "Error: Line " << 1 + countLineBreaks(script, 0, ex.position) << ": " << ex.message;
+                outError = error.str();
+                return false;
+            }
+
+            outList.insert(outList.end(), statements.begin(), statements.end());
+
+            // Offsets are ascending: line breaks are counted from the previous statement only
+            int line = 1;
+            size_t position = 0;
+            for (std::vector<size_t>::const_iterator it = offsets.begin(); it != offsets.end(); ++it) {
+                line += countLineBreaks(script, position, *it);
+                position = *it;
+                outLines.push_back(line);
+            }
+            return true;
+        }
+
+        bool hasCompileTimeObjects(const std::string &script)
+        {
+            std::vector<std::string> statements;
+            std::vector<size_t> offsets;
+            try {
+                Splitter splitter(script, statements, offsets);
+                splitter.split();
+                return splitter.hasRegex() || splitter.hasFunction();
+            } catch (const SyntaxError &) {
+                return true;
+            }
+        }
+    }
+}
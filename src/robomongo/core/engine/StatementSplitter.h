@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace Robomongo
+{
+    namespace StatementSplitter
+    {
+        /**
+         * @brief Splits JavaScript program into top-level statements (the same
+         * statements, that are listed in "body" of Esprima's Program node).
+         * Statement text starts with its first token and ends with its last token
+         * (including terminating semicolon), comments between statements are skipped.
+         *
+         * Splitter is a lexer with bracket tracking, not a full parser: it reports
+         * unterminated strings, comments, regular expressions and unbalanced brackets,
+         * other syntax errors are reported by JavaScript engine, when statement is compiled.
+         *
+         * @param outError: error in Esprima format ("Error: Line 3: Unexpected token )").
+         * @returns false, if script can't be split. 'outList' is left empty in this case.
+         */
+        bool split(const std::string &script, std::vector<std::string> &outList, std::string &outError);
+
+        /**
+         * @brief Same as above, 'outLines' receives line number (1-based), where each statement starts.
+         */
+        bool split(const std::string &script, std::vector<std::string> &outList, std::vector<int> &outLines, std::string &outError);
+
+        /**
+         * @brief Tests whether script contains regular expression literal (slash is
+         * classified as regex or division the same way as by split()) or function.
+         * JavaScript engine creates objects of them, when script is compiled, so these
+         * objects are shared by executions of compiled script. Scripts, that can't be
+         * split, are reported as containing such objects.
+         */
+        bool hasCompileTimeObjects(const std::string &script);
+    }
+}
@@ -9,6 +9,8 @@ namespace Robomongo
     R_REGISTER_EVENT(LoadDatabaseNamesResponse)
     R_REGISTER_EVENT(LoadCollectionNamesRequest)
     R_REGISTER_EVENT(LoadCollectionNamesResponse)
+    R_REGISTER_EVENT(LoadCollectionStatsRequest)
+    R_REGISTER_EVENT(LoadCollectionStatsResponse)
     R_REGISTER_EVENT(LoadUsersRequest)
     R_REGISTER_EVENT(LoadCollectionIndexesRequest)
     R_REGISTER_EVENT(LoadCollectionIndexesResponse)
@@ -26,6 +28,9 @@ namespace Robomongo
     R_REGISTER_EVENT(OpeningShellEvent)
     R_REGISTER_EVENT(ExecuteQueryRequest)
     R_REGISTER_EVENT(ExecuteQueryResponse)
+    R_REGISTER_EVENT(ReleaseQueryCursorsRequest)
+    R_REGISTER_EVENT(CreateScriptScopeRequest)
+    R_REGISTER_EVENT(ReleaseScriptScopeRequest)
     R_REGISTER_EVENT(DocumentListLoadedEvent)
     R_REGISTER_EVENT(ExecuteScriptRequest)
     R_REGISTER_EVENT(ExecuteScriptResponse)
@@ -35,8 +40,14 @@ namespace Robomongo
     R_REGISTER_EVENT(ScriptExecutingEvent)
     R_REGISTER_EVENT(InsertDocumentRequest)
     R_REGISTER_EVENT(InsertDocumentResponse)
+    R_REGISTER_EVENT(InsertDocumentsRequest)
+    R_REGISTER_EVENT(InsertDocumentsResponse)
+    R_REGISTER_EVENT(UpdateDocumentRequest)
+    R_REGISTER_EVENT(UpdateDocumentResponse)
     R_REGISTER_EVENT(RemoveDocumentRequest)
     R_REGISTER_EVENT(RemoveDocumentResponse)
+    R_REGISTER_EVENT(RemoveDocumentsRequest)
+    R_REGISTER_EVENT(RemoveDocumentsResponse)
     R_REGISTER_EVENT(CreateDatabaseRequest)
     R_REGISTER_EVENT(CreateDatabaseResponse)
     R_REGISTER_EVENT(DropDatabaseRequest)
@@ -60,4 +71,5 @@ namespace Robomongo
     R_REGISTER_EVENT(DropFunctionRequest)
     R_REGISTER_EVENT(DropFunctionResponse)
     R_REGISTER_EVENT(QueryWidgetUpdatedEvent)
+    R_REGISTER_EVENT(OperationProgressEvent)
 }
@@ -10,6 +10,7 @@
 #include "robomongo/core/domain/MongoUser.h"
 #include "robomongo/core/domain/MongoFunction.h"
 #include "robomongo/core/events/MongoEventsInfo.h"
+#include "robomongo/core/mongodb/OperationToken.h"
 #include "robomongo/core/Event.h"
 #include "robomongo/core/Enums.h"
 
@@ -94,14 +95,20 @@ namespace Robomongo
         R_EVENT
 
     public:
-        LoadCollectionNamesRequest(QObject *sender, const std::string &databaseName) :
+        /**
+         * @param loadStats: load statistics of all collections after names.
+         */
+        LoadCollectionNamesRequest(QObject *sender, const std::string &databaseName, bool loadStats = true) :
             Event(sender),
-            _databaseName(databaseName) {}
+            _databaseName(databaseName),
+            _loadStats(loadStats) {}
 
         std::string databaseName() const { return _databaseName; }
+        bool loadStats() const { return _loadStats; }
 
     private:
         std::string _databaseName;
+        bool _loadStats;
     };
 
     class LoadCollectionNamesResponse : public Event
@@ -126,6 +133,50 @@ namespace Robomongo
         std::vector<MongoCollectionInfo> _collectionInfos;
     };
 
+    /**
+     * @brief Load statistics of specified collections only.
+     */
+    class LoadCollectionStatsRequest : public Event
+    {
+        R_EVENT
+
+    public:
+        LoadCollectionStatsRequest(QObject *sender, const std::string &databaseName,
+                                   const std::vector<std::string> &namespaces) :
+            Event(sender),
+            _databaseName(databaseName),
+            _namespaces(namespaces) {}
+
+        std::string databaseName() const { return _databaseName; }
+        std::vector<std::string> namespaces() const { return _namespaces; }
+
+    private:
+        std::string _databaseName;
+        std::vector<std::string> _namespaces;
+    };
+
+    /**
+     * @brief Statistics for part of collections, listed by LoadCollectionNamesResponse.
+     */
+    class LoadCollectionStatsResponse : public Event
+    {
+        R_EVENT
+
+    public:
+        LoadCollectionStatsResponse(QObject *sender, const std::string &databaseName,
+                                    const std::vector<MongoCollectionInfo> &collectionInfos) :
+            Event(sender),
+            _databaseName(databaseName),
+            _collectionInfos(collectionInfos) { }
+
+        std::string databaseName() const { return _databaseName; }
+        std::vector<MongoCollectionInfo> collectionInfos() const { return _collectionInfos; }
+
+    private:
+        std::string _databaseName;
+        std::vector<MongoCollectionInfo> _collectionInfos;
+    };
+
     class LoadCollectionIndexesRequest : public Event
     {
         R_EVENT
@@ -328,6 +379,143 @@ namespace Robomongo
             Event(sender, error) {}
     };
 
+    /**
+     * @brief Insert Documents. Documents are inserted by worker with
+     * multi-document inserts, bounded by number and size of documents.
+     */
+
+    class InsertDocumentsRequest : public Event
+    {
+        R_EVENT
+
+    public:
+        InsertDocumentsRequest(QObject *sender, const std::vector<mongo::BSONObj> &documents, const MongoNamespace &ns,
+                               const OperationTokenPtr &token) :
+            Event(sender),
+            _documents(documents),
+            _ns(ns),
+            _token(token) {}
+
+        const std::vector<mongo::BSONObj> &documents() const { return _documents; }
+        MongoNamespace ns() const { return _ns; }
+        OperationTokenPtr token() const { return _token; }
+
+    private:
+        const std::vector<mongo::BSONObj> _documents;
+        const MongoNamespace _ns;
+        const OperationTokenPtr _token;
+    };
+
+    /**
+     * @brief Sent once, when all batches are processed. If some batches
+     * failed, response has error and 'inserted' is number of documents in
+     * successful batches.
+     */
+    class InsertDocumentsResponse : public Event
+    {
+        R_EVENT
+
+    public:
+        InsertDocumentsResponse(QObject *sender, const MongoNamespace &ns, const std::vector<mongo::BSONObj> &documents,
+                                long long inserted) :
+            Event(sender),
+            _ns(ns),
+            _documents(documents),
+            _inserted(inserted) {}
+
+        InsertDocumentsResponse(QObject *sender, const MongoNamespace &ns, const std::vector<mongo::BSONObj> &documents,
+                                long long inserted, const EventError &error) :
+            Event(sender, error),
+            _ns(ns),
+            _documents(documents),
+            _inserted(inserted) {}
+
+        MongoNamespace ns() const { return _ns; }
+
+        /**
+         * @brief Documents of the request (all of them are inserted, if there is no error).
+         */
+        const std::vector<mongo::BSONObj> &documents() const { return _documents; }
+
+        /**
+         * @brief Number of documents in batches, confirmed by server without error
+         * (before cancellation or failure as well).
+         */
+        long long inserted() const { return _inserted; }
+
+    private:
+        const MongoNamespace _ns;
+        const std::vector<mongo::BSONObj> _documents;
+        const long long _inserted;
+    };
+
+    /**
+     * @brief Update Document. Worker saves edited document with $set/$unset
+     * of changed fields (see BsonUtils::buildUpdate).
+     */
+
+    class UpdateDocumentRequest : public Event
+    {
+        R_EVENT
+
+    public:
+        UpdateDocumentRequest(QObject *sender, const mongo::BSONObj &original, const mongo::BSONObj &edited,
+                              const MongoNamespace &ns, bool checkConflicts) :
+            Event(sender),
+            _original(original),
+            _edited(edited),
+            _ns(ns),
+            _checkConflicts(checkConflicts) {}
+
+        mongo::BSONObj original() const { return _original; }
+        mongo::BSONObj edited() const { return _edited; }
+        MongoNamespace ns() const { return _ns; }
+
+        /**
+         * @brief Update only if changed fields still have original values on server.
+         */
+        bool checkConflicts() const { return _checkConflicts; }
+
+    private:
+        const mongo::BSONObj _original;
+        const mongo::BSONObj _edited;
+        const MongoNamespace _ns;
+        const bool _checkConflicts;
+    };
+
+    class UpdateDocumentResponse : public Event
+    {
+        R_EVENT
+
+    public:
+        UpdateDocumentResponse(QObject *sender, const MongoNamespace &ns, const mongo::BSONObj &original,
+                               const mongo::BSONObj &edited) :
+            Event(sender),
+            _ns(ns),
+            _original(original),
+            _edited(edited) {}
+
+        UpdateDocumentResponse(QObject *sender, const MongoNamespace &ns, const mongo::BSONObj &original,
+                               const mongo::BSONObj &edited, const EventError &error) :
+            Event(sender, error),
+            _ns(ns),
+            _original(original),
+            _edited(edited) {}
+
+        MongoNamespace ns() const { return _ns; }
+        mongo::BSONObj original() const { return _original; }
+
+        /**
+         * @brief Saved document (if there is no error).
+         */
+        mongo::BSONObj edited() const { return _edited; }
+
+    private:
+        const MongoNamespace _ns;
+        const mongo::BSONObj _original;
+        const mongo::BSONObj _edited;
+    };
+
     /**
      * @brief Remove Document
      */
@@ -365,6 +553,70 @@ namespace Robomongo
             Event(sender, error) {}
     };
 
+    /**
+     * @brief Remove Documents by _id. 'ids' are { _id : value } objects,
+     * worker removes them with $in queries.
+     */
+
+    class RemoveDocumentsRequest : public Event
+    {
+        R_EVENT
+
+    public:
+        RemoveDocumentsRequest(QObject *sender, const std::vector<mongo::BSONObj> &ids, const MongoNamespace &ns,
+                               const OperationTokenPtr &token) :
+            Event(sender),
+            _ids(ids),
+            _ns(ns),
+            _token(token) {}
+
+        const std::vector<mongo::BSONObj> &ids() const { return _ids; }
+        MongoNamespace ns() const { return _ns; }
+        OperationTokenPtr token() const { return _token; }
+
+    private:
+        const std::vector<mongo::BSONObj> _ids;
+        const MongoNamespace _ns;
+        const OperationTokenPtr _token;
+    };
+
+    class RemoveDocumentsResponse : public Event
+    {
+        R_EVENT
+
+    public:
+        RemoveDocumentsResponse(QObject *sender, const MongoNamespace &ns, const std::vector<mongo::BSONObj> &ids,
+                                long long removed) :
+            Event(sender),
+            _ns(ns),
+            _ids(ids),
+            _removed(removed) {}
+
+        RemoveDocumentsResponse(QObject *sender, const MongoNamespace &ns, const std::vector<mongo::BSONObj> &ids,
+                                long long removed, const EventError &error) :
+            Event(sender, error),
+            _ns(ns),
+            _ids(ids),
+            _removed(removed) {}
+
+        MongoNamespace ns() const { return _ns; }
+
+        /**
+         * @brief { _id : value } objects of the request.
+         */
+        const std::vector<mongo::BSONObj> &ids() const { return _ids; }
+
+        /**
+         * @brief Number of documents, reported as removed by server.
+         */
+        long long removed() const { return _removed; }
+
+    private:
+        const MongoNamespace _ns;
+        const std::vector<mongo::BSONObj> _ids;
+        const long long _removed;
+    };
+
     /**
      * @brief Create Database
      */
@@ -407,14 +659,17 @@ namespace Robomongo
         R_EVENT
 
     public:
-        DropDatabaseRequest(QObject *sender, const std::string &database) :
+        DropDatabaseRequest(QObject *sender, const std::string &database, const OperationTokenPtr &token) :
             Event(sender),
-            _database(database) {}
+            _database(database),
+            _token(token) {}
 
         std::string database() const { return _database; }
+        OperationTokenPtr token() const { return _token; }
 
     private:
         std::string _database;
+        OperationTokenPtr _token;
     };
 
     class DropDatabaseResponse : public Event
@@ -536,17 +791,21 @@ namespace Robomongo
         R_EVENT
 
     public:
-        DuplicateCollectionRequest(QObject *sender, const MongoNamespace &ns, const std::string &newCollection) :
+        DuplicateCollectionRequest(QObject *sender, const MongoNamespace &ns, const std::string &newCollection,
+                                   const OperationTokenPtr &token) :
             Event(sender),
             _ns(ns),
-            _newCollection(newCollection) {}
+            _newCollection(newCollection),
+            _token(token) {}
 
         MongoNamespace ns() const { return _ns; }
         std::string newCollection() const { return _newCollection; }
+        OperationTokenPtr token() const { return _token; }
 
     private:
         MongoNamespace _ns;
         std::string _newCollection;
+        OperationTokenPtr _token;
     };
 
     class DuplicateCollectionResponse : public Event
@@ -571,19 +830,22 @@ namespace Robomongo
 
     public:
         CopyCollectionToDiffServerRequest(QObject *sender, MongoWorker *worker, const std::string &databaseFrom,
-            const std::string &collection, const std::string &databaseTo) :
+            const std::string &collection, const std::string &databaseTo, const OperationTokenPtr &token) :
         Event(sender),
             _worker(worker),
             _from(databaseFrom, collection),
-            _to(databaseTo, collection) {}
+            _to(databaseTo, collection),
+            _token(token) {}
 
         MongoWorker *worker() const { return _worker; }
         MongoNamespace from() const { return _from;}
         MongoNamespace to() const { return _to; }
+        OperationTokenPtr token() const { return _token; }
     private:
         MongoWorker *_worker;
         const MongoNamespace _from;
         const MongoNamespace _to;
+        const OperationTokenPtr _token;
     };
 
     class CopyCollectionToDiffServerResponse : public Event
@@ -598,6 +860,7 @@ namespace Robomongo
             Event(sender, error) {}
     };
 
+
     /**
      * @brief Create User
      */
@@ -756,35 +1019,92 @@ namespace Robomongo
         R_EVENT
 
     public:
-        ExecuteQueryRequest(QObject *sender, int resultIndex, const MongoQueryInfo &queryInfo) :
+        ExecuteQueryRequest(QObject *sender, int resultIndex, const MongoQueryInfo &queryInfo, const OperationTokenPtr &token) :
             Event(sender),
             _resultIndex(resultIndex),
-            _queryInfo(queryInfo) {}
+            _queryInfo(queryInfo),
+            _token(token) {}
 
         int resultIndex() const { return _resultIndex; }
         MongoQueryInfo queryInfo() const { return _queryInfo; }
+        OperationTokenPtr token() const { return _token; }
 
     private:
         int _resultIndex; //external user data;
         MongoQueryInfo _queryInfo;
+        OperationTokenPtr _token;
     };
 
     class ExecuteQueryResponse : public Event
     {
         R_EVENT
 
-        ExecuteQueryResponse(QObject *sender, int resultIndex, const MongoQueryInfo &queryInfo, const std::vector<MongoDocumentPtr> &documents) :
+        ExecuteQueryResponse(QObject *sender, int resultIndex, const MongoQueryInfo &queryInfo, const std::vector<MongoDocumentPtr> &documents,
+                             bool isFirstPart = true, bool isLastPart = true) :
             Event(sender),
             resultIndex(resultIndex),
             queryInfo(queryInfo),
-            documents(documents) { }
+            documents(documents),
+            isFirstPart(isFirstPart),
+            isLastPart(isLastPart) { }
 
         ExecuteQueryResponse(QObject *sender, const EventError &error) :
-            Event(sender, error) {}
+            Event(sender, error),
+            resultIndex(-1),
+            isFirstPart(false),
+            isLastPart(true) {}
 
         int resultIndex;
         MongoQueryInfo queryInfo;
         std::vector<MongoDocumentPtr> documents;
+
+        /**
+         * @brief Query results are streamed in parts, one per server batch.
+         * First part replaces previous results, others should be appended.
+         */
+        bool isFirstPart;
+        bool isLastPart;
+    };
+
+    /**
+     * @brief Close server-side cursors, kept open for paging of results
+     * of the 'sender' (results view is closed or replaced).
+     */
+    class ReleaseQueryCursorsRequest : public Event
+    {
+        R_EVENT
+
+    public:
+        ReleaseQueryCursorsRequest(QObject *sender) :
+            Event(sender) {}
+    };
+
+    /**
+     * @brief Create JavaScript scope of the 'sender' shell (shell is opened), so that
+     * default database of the shell is selected before its first request.
+     */
+    class CreateScriptScopeRequest : public Event
+    {
+        R_EVENT
+
+    public:
+        CreateScriptScopeRequest(QObject *sender, const std::string &defaultDatabase) :
+            Event(sender),
+            defaultDatabase(defaultDatabase) {}
+
+        std::string defaultDatabase;
+    };
+
+    /**
+     * @brief Delete JavaScript scope of the 'sender' shell (shell is closed).
+     */
+    class ReleaseScriptScopeRequest : public Event
+    {
+        R_EVENT
+
+    public:
+        ReleaseScriptScopeRequest(QObject *sender) :
+            Event(sender) {}
     };
 
     class AutocompleteRequest : public Event
@@ -917,23 +1237,30 @@ namespace Robomongo
         R_EVENT
 
     public:
-        DocumentListLoadedEvent(QObject *sender, int resultIndex, const MongoQueryInfo &queryInfo, const std::string &query, const std::vector<MongoDocumentPtr> &docs) :
+        DocumentListLoadedEvent(QObject *sender, int resultIndex, const MongoQueryInfo &queryInfo, const std::string &query, const std::vector<MongoDocumentPtr> &docs,
+                                bool isFirstPart = true, bool isLastPart = true) :
             Event(sender),
             _resultIndex(resultIndex),
             _queryInfo(queryInfo),
             _query(query),
-            _documents(docs) { }
+            _documents(docs),
+            _isFirstPart(isFirstPart),
+            _isLastPart(isLastPart) { }
 
         int resultIndex() const { return _resultIndex; }
         MongoQueryInfo queryInfo() const { return _queryInfo; }
         std::vector<MongoDocumentPtr> documents() const { return _documents; }
         std::string query() const { return _query; }
+        bool isFirstPart() const { return _isFirstPart; }
+        bool isLastPart() const { return _isLastPart; }
 
     private:
         int _resultIndex;
         MongoQueryInfo _queryInfo;
         std::vector<MongoDocumentPtr> _documents;
         std::string _query;
+        bool _isFirstPart;
+        bool _isLastPart;
     };
 
     class ScriptExecutedEvent : public Event
@@ -977,4 +1304,66 @@ namespace Robomongo
     private:
         int _numOfResults;
     };
+
+    /**
+     * @brief Progress of long running worker operation. Replied to requester
+     * not more often than once per MongoWorker::progressIntervalMs, and once
+     * more when operation is finished (completed, failed or cancelled).
+     * 'token' allows to cancel the operation.
+     */
+    class OperationProgressEvent : public Event
+    {
+        R_EVENT
+
+    public:
+        OperationProgressEvent(QObject *sender, const OperationTokenPtr &token, const std::string &description,
+                               long long done, long long total, double perSecond, long long etaMs, bool finished) :
+            Event(sender),
+            _token(token),
+            _description(description),
+            _done(done),
+            _total(total),
+            _perSecond(perSecond),
+            _etaMs(etaMs),
+            _finished(finished) {}
+
+        /**
+         * @brief Same progress, republished by 'sender'.
+         */
+        OperationProgressEvent(QObject *sender, const OperationProgressEvent &other) :
+            Event(sender),
+            _token(other._token),
+            _description(other._description),
+            _done(other._done),
+            _total(other._total),
+            _perSecond(other._perSecond),
+            _etaMs(other._etaMs),
+            _finished(other._finished) {}
+
+        OperationTokenPtr token() const { return _token; }
+        std::string description() const { return _description; }
+        long long done() const { return _done; }
+
+        /**
+         * @brief Expected amount of work (i.e. number of documents), 0 if unknown.
+         */
+        long long total() const { return _total; }
+        double perSecond() const { return _perSecond; }
+        long long etaMs() const { return _etaMs; }
+        bool isFinished() const { return _finished; }
+
+        /**
+         * @brief Only final event is always delivered.
+         */
+        virtual bool isCoalescable() const { return !_finished; }
+
+    private:
+        const OperationTokenPtr _token;
+        const std::string _description;
+        const long long _done;
+        const long long _total;
+        const double _perSecond;
+        const long long _etaMs;
+        const bool _finished;
+    };
 }
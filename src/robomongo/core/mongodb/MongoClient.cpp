@@ -1,11 +1,29 @@
 #include "robomongo/core/mongodb/MongoClient.h"
 
+#include <sstream>
+#include <algorithm>
+#include <mongo/db/dbmessage.h>
+
 #include "robomongo/core/domain/MongoDocument.h"
 #include "robomongo/core/utils/BsonUtils.h"
 #include "robomongo/shell/db/json.h"
 
+namespace mongo
+{
+    void assembleRequest(const std::string &ns, BSONObj query, int nToReturn, int nToSkip,
+                         const BSONObj *fieldsToReturn, int queryOptions, Message &toSend);
+}
+
 namespace
 {
+    mongo::BSONObj collStatsCommand(const Robomongo::MongoNamespace &ns)
+    {
+        mongo::BSONObjBuilder command; // { collStats: "db.collection", scale : 1 }
+        command.append("collStats", ns.collectionName());
+        command.append("scale", 1);
+        return command.obj();
+    }
+
     Robomongo::EnsureIndexInfo makeEnsureIndexInfoFromBsonObj(
         const Robomongo::MongoCollectionInfo &collection,
         const mongo::BSONObj &obj)
@@ -365,7 +383,7 @@ namespace Robomongo
         _dbclient->runCommand("admin", command.obj(), result); // this command should be run against "admin" db
     }
 
-    void MongoClient::duplicateCollection(const MongoNamespace &ns, const std::string &newCollectionName)
+    void MongoClient::duplicateCollection(const MongoNamespace &ns, const std::string &newCollectionName, OperationProgressListener *listener)
     {
         MongoNamespace from(ns);
         MongoNamespace to(ns.databaseName(), newCollectionName);
@@ -373,22 +391,54 @@ namespace Robomongo
         if (!_dbclient->exists(to.toString()))
             _dbclient->createCollection(to.toString());
 
-        std::auto_ptr<mongo::DBClientCursor> cursor(_dbclient->query(from.toString(), mongo::Query()));
-        while (cursor->more()) {
-            mongo::BSONObj bsonObj = cursor->next();
-            _dbclient->insert(to.toString(), bsonObj);
-        }
+        copyDocuments(_dbclient, from, to, listener);
     }
 
-    void MongoClient::copyCollectionToDiffServer(mongo::DBClientConnection *const fromServ,const MongoNamespace &from, const MongoNamespace &to)
+    void MongoClient::copyCollectionToDiffServer(mongo::DBClientConnection *const fromServ,const MongoNamespace &from, const MongoNamespace &to, OperationProgressListener *listener)
     {
         if (!_dbclient->exists(to.toString()))
             _dbclient->createCollection(to.toString());
 
-        std::auto_ptr<mongo::DBClientCursor> cursor(fromServ->query(from.toString(), mongo::Query()));
+        copyDocuments(fromServ, from, to, listener);
+    }
+
+    void MongoClient::copyDocuments(mongo::DBClientConnection *source, const MongoNamespace &from, const MongoNamespace &to, OperationProgressListener *listener)
+    {
+        long long total = source->count(from.toString());
+        long long copied = 0;
+
+        std::auto_ptr<mongo::DBClientCursor> cursor(source->query(from.toString(), mongo::Query(), 0, 0, NULL, 0, insertBatchDocuments));
+        if (!cursor.get())
+            throw mongo::UserException(0, "Unable to query documents of " + from.toString());
+
+        std::vector<mongo::BSONObj> batch;
+        batch.reserve(insertBatchDocuments);
+        size_t batchBytes = 0;
+
         while (cursor->more()) {
-            mongo::BSONObj bsonObj = cursor->next();
-            _dbclient->insert(to.toString(), bsonObj);
+            mongo::BSONObj bsonObj = cursor->next().getOwned();
+            batchBytes += bsonObj.objsize();
+            batch.push_back(bsonObj);
+
+            if (batch.size() < insertBatchDocuments && batchBytes < insertBatchBytes && cursor->moreInCurrentBatch())
+                continue;
+
+            // With ContinueOnError server inserts the rest of batch after failed document,
+            // getLastError reports the last failure of the batch.
+            _dbclient->insert(to.toString(), batch, mongo::InsertOption_ContinueOnError);
+            std::string error = _dbclient->getLastError();
+            if (!error.empty()) {
+                std::stringstream message;
+                message << "Documents " << copied + 1 << "-" << copied + batch.size() << " of " << total << ": " << error;
+                throw mongo::UserException(0, message.str());
+            }
+
+            copied += batch.size();
+            batch.clear();
+            batchBytes = 0;
+
+            if (listener)
+                listener->progress(copied, total);
         }
     }
 
@@ -402,6 +452,43 @@ namespace Robomongo
         _dbclient->insert(ns.toString(), obj);
     }
 
+    void MongoClient::insertDocuments(const std::vector<mongo::BSONObj> &documents, const MongoNamespace &ns, long long &inserted,
+                                      std::vector<std::string> &errors, OperationProgressListener *listener)
+    {
+        const std::string nsString = ns.toString();
+        std::vector<mongo::BSONObj> batch;
+        batch.reserve(std::min<size_t>(documents.size(), insertBatchDocuments));
+        size_t batchBytes = 0;
+        size_t batchStart = 0;
+
+        for (size_t i = 0; i < documents.size(); ++i) {
+            batchBytes += documents[i].objsize();
+            batch.push_back(documents[i]);
+
+            if (i + 1 < documents.size() && batch.size() < insertBatchDocuments && batchBytes < insertBatchBytes)
+                continue;
+
+            // With ContinueOnError server inserts the rest of batch after failed document,
+            // getLastError reports the last failure of the batch.
+            _dbclient->insert(nsString, batch, mongo::InsertOption_ContinueOnError);
+            std::string error = _dbclient->getLastError();
+            if (error.empty()) {
+                inserted += batch.size();
+            } else {
+                std::stringstream message;
+                message << "Documents " << batchStart + 1 << "-" << i + 1 << " of " << documents.size() << ": " << error;
+                errors.push_back(message.str());
+            }
+
+            batch.clear();
+            batchBytes = 0;
+            batchStart = i + 1;
+
+            if (listener)
+                listener->progress(i + 1, documents.size());
+        }
+    }
+
     void MongoClient::saveDocument(const mongo::BSONObj &obj, const MongoNamespace &ns)
     {
 
@@ -415,45 +502,146 @@ namespace Robomongo
         //_dbclient->save(ns.toString().toStdString(), obj);
     }
 
+    void MongoClient::updateDocument(const mongo::BSONObj &original, const mongo::BSONObj &edited, const MongoNamespace &ns,
+                                     bool checkConflicts)
+    {
+        mongo::BSONObj update;
+        mongo::BSONObj matchOriginal;
+        bool isPartial = BsonUtils::buildUpdate(original, edited, update, matchOriginal);
+        if (isPartial && update.isEmpty())
+            return;
+
+        mongo::BSONElement id = original.getField("_id");
+        bool isSameId = !id.eoo() && id.valuesEqual(edited.getField("_id"));
+        if (!isSameId || (!isPartial && !checkConflicts)) {
+            // Document with other _id is saved as before: upsert of whole document
+            saveDocument(edited, ns);
+            return;
+        }
+
+        mongo::BSONObjBuilder query;
+        if (!checkConflicts) {
+            query.append(id);
+        } else if (isPartial) {
+            query.append(id);
+            query.appendElements(matchOriginal);
+        } else {
+            query.appendElements(original);
+        }
+
+        _dbclient->update(ns.toString(), mongo::Query(query.obj()), isPartial ? update : edited);
+        mongo::BSONObj lastError = _dbclient->getLastErrorDetailed();
+        std::string error = mongo::DBClientWithCommands::getLastErrorString(lastError);
+        if (!error.empty())
+            throw mongo::UserException(0, error);
+
+        if (lastError.getIntField("n") > 0)
+            return;
+
+        if (checkConflicts)
+            throw mongo::UserException(0, "Document was changed or removed on server after it was loaded.");
+
+        // Document was removed after it was loaded
+        saveDocument(edited, ns);
+    }
+
     void MongoClient::removeDocuments(const MongoNamespace &ns, mongo::Query query, bool justOne /*= true*/)
     {
         _dbclient->remove(ns.toString(), query, justOne);
     }
 
-    std::vector<MongoDocumentPtr> MongoClient::query(const MongoQueryInfo &info)
+    long long MongoClient::removeDocuments(const MongoNamespace &ns, const std::vector<mongo::BSONObj> &ids,
+                                           OperationProgressListener *listener)
     {
-        MongoNamespace ns(info._info._ns);
+        const std::string nsString = ns.toString();
+        long long removed = 0;
+        size_t i = 0;
+
+        while (i < ids.size()) {
+            mongo::BSONObjBuilder query;
+            mongo::BSONObjBuilder idQuery(query.subobjStart("_id"));
+            mongo::BSONArrayBuilder in(idQuery.subarrayStart("$in"));
+            do {
+                in.append(ids[i].firstElement());
+                ++i;
+            } while (i < ids.size() && in.len() < removeBatchBytes);
+            in.done();
+            idQuery.done();
+
+            // Every remove is acknowledged to count removed documents
+            _dbclient->remove(nsString, mongo::Query(query.obj()));
+            mongo::BSONObj lastError = _dbclient->getLastErrorDetailed();
+            std::string error = mongo::DBClientWithCommands::getLastErrorString(lastError);
+            if (!error.empty())
+                throw mongo::UserException(0, error);
+
+            removed += lastError.getIntField("n");
+
+            if (listener)
+                listener->progress(i, ids.size());
+        }
 
-        //int limit = (info.limit <= 0) ? 50 : info.limit;
+        return removed;
+    }
 
+    std::vector<MongoDocumentPtr> MongoClient::query(const MongoQueryInfo &info)
+    {
         std::vector<MongoDocumentPtr> docs;
 
-        if (info._limit == -1) // it means that we do not need to load any documents
+        std::auto_ptr<mongo::DBClientCursor> cursor = openCursor(info);
+        if (!cursor.get())
             return docs;
 
-        std::auto_ptr<mongo::DBClientCursor> cursor = _dbclient->query(
+        while (cursor->more()) {
+            mongo::BSONObj bsonObj = cursor->next();
+            MongoDocumentPtr doc(new MongoDocument(bsonObj.getOwned()));
+            docs.push_back(doc);
+        }
+
+        return docs;
+    }
+
+    std::auto_ptr<mongo::DBClientCursor> MongoClient::openCursor(const MongoQueryInfo &info)
+    {
+        MongoNamespace ns(info._info._ns);
+
+        if (info._limit == -1) // it means that we do not need to load any documents
+            return std::auto_ptr<mongo::DBClientCursor>();
+
+        return _dbclient->query(
             ns.toString(), info._query, info._limit, info._skip,
             info._fields.nFields() ? &info._fields : 0, info._options, info._batchSize);
+    }
 
+    bool MongoClient::readPart(mongo::DBClientCursor *cursor, std::vector<MongoDocumentPtr> &docs,
+                               size_t maxCount, size_t maxBytes)
+    {
+        size_t count = 0;
+        size_t bytes = 0;
         while (cursor->more()) {
             mongo::BSONObj bsonObj = cursor->next();
             MongoDocumentPtr doc(new MongoDocument(bsonObj.getOwned()));
             docs.push_back(doc);
+
+            // Stop at the end of server batch, otherwise next call
+            // to more() will wait for the next getMore round trip
+            if (!cursor->moreInCurrentBatch())
+                return !cursor->isDead();
+
+            bytes += bsonObj.objsize();
+            if (++count >= maxCount || bytes >= maxBytes)
+                return true;
         }
 
-        return docs;
+        return false;
     }
 
     MongoCollectionInfo MongoClient::runCollStatsCommand(const std::string &ns)
     {
         MongoNamespace mongons(ns);
 
-        mongo::BSONObjBuilder command; // { collStats: "db.collection", scale : 1 }
-        command.append("collStats", mongons.collectionName());
-        command.append("scale", 1);
-
         mongo::BSONObj result;
-        _dbclient->runCommand(mongons.databaseName(), command.obj(), result);
+        _dbclient->runCommand(mongons.databaseName(), collStatsCommand(mongons), result);
         std::string isCV = result.toString();
         MongoCollectionInfo newInfo(result);
         return newInfo;
@@ -462,15 +650,70 @@ namespace Robomongo
     std::vector<MongoCollectionInfo> MongoClient::runCollStatsCommand(const std::vector<std::string> &namespaces)
     {
         std::vector<MongoCollectionInfo> infos;
-        for (std::vector<std::string>::const_iterator it = namespaces.begin(); it!=namespaces.end(); ++it) {
-            MongoCollectionInfo info = runCollStatsCommand(*it);
-            if (info.ns().isValid()){
-                infos.push_back(info);
-            }            
+        std::vector<int> requestIds;
+        requestIds.reserve(namespaces.size());
+        size_t received = 0;
+        bool isInSync = true;
+
+        try {
+            for (std::vector<std::string>::const_iterator it = namespaces.begin(); it!=namespaces.end(); ++it) {
+                MongoNamespace mongons(*it);
+                mongo::Message toSend;
+                mongo::assembleRequest(mongons.databaseName() + ".$cmd", collStatsCommand(mongons), 1, 0, NULL, 0, toSend);
+                _dbclient->say(toSend);
+                requestIds.push_back(toSend.header()->id);
+            }
+
+            // Server answers in the order of requests
+            while (received < requestIds.size()) {
+                mongo::Message response;
+                if (!_dbclient->recv(response))
+                    throw mongo::UserException(10278, "dbclient error communicating with server: " + _dbclient->getServerAddress());
+
+                if (response.header()->responseTo != requestIds[received]) {
+                    isInSync = false;
+                    throw mongo::UserException(0, "collStats reply doesn't match request: " + _dbclient->getServerAddress());
+                }
+                ++received;
+
+                mongo::QueryResult *result = (mongo::QueryResult *) response.singleData();
+                if (result->nReturned != 1)
+                    continue;
+
+                MongoCollectionInfo info(mongo::BSONObj(result->data()).getOwned());
+                if (info.ns().isValid()) {
+                    infos.push_back(info);
+                }
+            }
+        } catch (const mongo::DBException &) {
+            discardReplies(requestIds.size() - received, isInSync);
+            throw;
         }
         return infos;
     }
 
+    /**
+     * @brief Reads replies of pipelined requests, that will not be processed, so that
+     * next command on connection gets its own reply. If stream of replies can't be
+     * restored, connection is closed and marked as failed (it is reconnected on next use).
+     */
+    void MongoClient::discardReplies(size_t count, bool isInSync)
+    {
+        if (_dbclient->isFailed())
+            return;
+
+        for (size_t i = 0; isInSync && i < count; ++i) {
+            mongo::Message response;
+            isInSync = _dbclient->recv(response);
+        }
+
+        if (!isInSync && !_dbclient->isFailed()) {
+            _dbclient->port().shutdown();
+            mongo::Message response;
+            _dbclient->recv(response);
+        }
+    }
+
     void MongoClient::done()
     {
         // do nothing here, because we are not using ScopedDbConnection now
@@ -6,12 +6,24 @@
 #include "robomongo/core/domain/MongoUser.h"
 #include "robomongo/core/domain/MongoFunction.h"
 #include "robomongo/core/events/MongoEventsInfo.h"
+#include "robomongo/core/mongodb/OperationToken.h"
 
 namespace Robomongo
 {
     class MongoClient
     {
     public:
+        /**
+         * @brief Limits of single multi-document insert, used while copying collections
+         * and inserting documents.
+         */
+        enum{insertBatchDocuments = 1000, insertBatchBytes = 8*1024*1024};
+
+        /**
+         * @brief Limit of size of _id's in single $in remove (query should fit into BSON limit).
+         */
+        enum{removeBatchBytes = 4*1024*1024};
+
         MongoClient(mongo::DBClientConnection *const scopedConnection);
 
         std::vector<std::string> getCollectionNames(const std::string &dbname) const;
@@ -39,21 +51,76 @@ namespace Robomongo
 
         void createCollection(const MongoNamespace &ns);
         void renameCollection(const MongoNamespace &ns, const std::string &newCollectionName);
-        void duplicateCollection(const MongoNamespace &ns, const std::string &newCollectionName);
+        void duplicateCollection(const MongoNamespace &ns, const std::string &newCollectionName, OperationProgressListener *listener = NULL);
         void dropCollection(const MongoNamespace &ns);
-        void copyCollectionToDiffServer(mongo::DBClientConnection *const,const MongoNamespace &from, const MongoNamespace &to);
+        void copyCollectionToDiffServer(mongo::DBClientConnection *const,const MongoNamespace &from, const MongoNamespace &to, OperationProgressListener *listener = NULL);
 
         void insertDocument(const mongo::BSONObj &obj, const MongoNamespace &ns);
+
+        /**
+         * @brief Inserts 'documents' with multi-document inserts, bounded by insertBatchDocuments
+         * and insertBatchBytes. Every batch is checked with getLastError, failed batch doesn't
+         * stop next batches: its range and error are appended to 'errors'.
+         * @param inserted: incremented by size of every batch, confirmed without error, as soon as
+         * it is confirmed (so it is valid, when insert is cancelled or fails with exception).
+         * Documents of failed batches are not counted: server doesn't report how many of them are inserted.
+         */
+        void insertDocuments(const std::vector<mongo::BSONObj> &documents, const MongoNamespace &ns, long long &inserted,
+                             std::vector<std::string> &errors, OperationProgressListener *listener = NULL);
         void saveDocument(const mongo::BSONObj &obj, const MongoNamespace &ns);
+
+        /**
+         * @brief Saves 'edited' version of 'original' document with update of changed fields.
+         * If 'checkConflicts' is true, document is updated only if these fields have original
+         * values on server, otherwise exception is thrown.
+         */
+        void updateDocument(const mongo::BSONObj &original, const mongo::BSONObj &edited, const MongoNamespace &ns,
+                            bool checkConflicts);
         void removeDocuments(const MongoNamespace &ns, mongo::Query query, bool justOne = true);
+
+        /**
+         * @brief Removes documents by 'ids' ({ _id : value } objects) with { _id : { $in : [...] } }
+         * removes, bounded by removeBatchBytes.
+         * @returns number of removed documents.
+         */
+        long long removeDocuments(const MongoNamespace &ns, const std::vector<mongo::BSONObj> &ids,
+                                  OperationProgressListener *listener = NULL);
         std::vector<MongoDocumentPtr> query(const MongoQueryInfo &info);
 
+        /**
+         * @brief Opens cursor for the specified query. Returns empty pointer
+         * if query should not load any documents (i.e. limit is -1).
+         */
+        std::auto_ptr<mongo::DBClientCursor> openCursor(const MongoQueryInfo &info);
+
+        /**
+         * @brief Reads next part of documents from cursor into 'docs'. Part ends when
+         * current server batch is exhausted, or when 'maxCount' documents or 'maxBytes'
+         * bytes were read, so no additional round trip is made to fill it.
+         * @returns false, if cursor has no more documents.
+         */
+        static bool readPart(mongo::DBClientCursor *cursor, std::vector<MongoDocumentPtr> &docs,
+                             size_t maxCount, size_t maxBytes);
+
         MongoCollectionInfo runCollStatsCommand(const std::string &ns);
+
+        /**
+         * @brief Pipelined collStats: all commands are written to the connection
+         * before reading the first response, so whole list costs single round trip.
+         * Collections, for which collStats failed, are not included into result.
+         */
         std::vector<MongoCollectionInfo> runCollStatsCommand(const std::vector<std::string> &namespaces);
 
         void done();
 
     private:
+        /**
+         * @brief Copies all documents of 'from' (read with 'source' connection)
+         * into 'to' collection of this connection.
+         */
+        void copyDocuments(mongo::DBClientConnection *source, const MongoNamespace &from, const MongoNamespace &to, OperationProgressListener *listener);
+        void discardReplies(size_t count, bool isInSync);
+
         mongo::DBClientConnection *const _dbclient;
     };
 }
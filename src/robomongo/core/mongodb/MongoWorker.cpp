@@ -1,6 +1,10 @@
 #include "robomongo/core/mongodb/MongoWorker.h"
 
 #include <QThread>
+#include <QElapsedTimer>
+#include <limits>
+#include <sstream>
+#include <algorithm>
 
 #include "robomongo/core/events/MongoEvents.h"
 #include "robomongo/core/engine/ScriptEngine.h"
@@ -15,15 +19,178 @@
 #include "robomongo/core/utils/Logger.h"
 #include "robomongo/core/utils/QtUtils.h"
 
+namespace
+{
+    bool isSameQuery(const Robomongo::MongoQueryInfo &first, const Robomongo::MongoQueryInfo &second)
+    {
+        return first._info._ns.toString() == second._info._ns.toString()
+            && first._query.binaryEqual(second._query)
+            && first._fields.binaryEqual(second._fields)
+            && first._options == second._options;
+    }
+
+    /**
+     * @brief Sorted queries are paged with skip: without limit server is not
+     * able to use top-k sort and unindexed sort of large result fails.
+     */
+    bool isPagingCursorSupported(const Robomongo::MongoQueryInfo &info)
+    {
+        if (info._limit <= 0)
+            return false;
+
+        if (info._special && (info._query.hasField("orderby") || info._query.hasField("$orderby")))
+            return false;
+
+        return true;
+    }
+
+    /**
+     * @brief Message about partially done insert: documents of confirmed batches and
+     * ranges of failed batches with their errors (server doesn't report how many documents
+     * of failed batch are inserted).
+     */
+    std::string insertErrorMessage(const std::string &description, long long inserted, size_t total,
+                                   const std::vector<std::string> &errors)
+    {
+        std::stringstream message;
+        message << description << " Inserted " << inserted << " of " << total << " documents";
+        if (!errors.empty())
+            message << ", failed batches (some of their documents may be inserted):";
+        else
+            message << ".";
+
+        for (std::vector<std::string>::const_iterator it = errors.begin(); it != errors.end(); ++it) {
+            message << "\n" << *it;
+        }
+        return message.str();
+    }
+
+    /**
+     * @brief Replies OperationProgressEvent to 'receiver', not more often than once
+     * per MongoWorker::progressIntervalMs. Throws, when operation is cancelled.
+     * Final event is sent by finish() or destructor (when operation failed),
+     * only if progress of the operation was reported before.
+     */
+    class OperationProgressReporter : public Robomongo::OperationProgressListener
+    {
+    public:
+        /**
+         * @param reportStart: report start of the operation immediately, so that
+         * it can be cancelled even if it doesn't report any progress.
+         */
+        OperationProgressReporter(QObject *sender, QObject *receiver, const Robomongo::OperationTokenPtr &token,
+                                  const std::string &description, bool reportStart) :
+            _sender(sender),
+            _receiver(receiver),
+            _token(token),
+            _description(description),
+            _done(0),
+            _total(0),
+            _isReported(false),
+            _isFinished(false)
+        {
+            _elapsed.start();
+            _lastReport.start();
+            if (reportStart)
+                report(false);
+        }
+
+        ~OperationProgressReporter()
+        {
+            finish();
+        }
+
+        virtual void progress(long long done, long long total)
+        {
+            update(done, total);
+            checkCancelled();
+        }
+
+        /**
+         * @brief Same as progress(), but doesn't throw if operation is cancelled.
+         */
+        void update(long long done, long long total)
+        {
+            _done = done;
+            _total = total;
+            if (_lastReport.elapsed() < Robomongo::MongoWorker::progressIntervalMs)
+                return;
+
+            _lastReport.restart();
+            report(false);
+        }
+
+        void checkCancelled() const
+        {
+            if (_token)
+                _token->checkCancelled();
+        }
+
+        bool isCancelled() const
+        {
+            return _token && _token->isCancelled();
+        }
+
+        void finish()
+        {
+            if (_isFinished)
+                return;
+
+            _isFinished = true;
+            if (_isReported)
+                report(true);
+        }
+
+    private:
+        void report(bool finished)
+        {
+            _isReported = true;
+            qint64 elapsedMs = std::max<qint64>(_elapsed.elapsed(), 1);
+            double perSecond = _done * 1000.0 / elapsedMs;
+            long long etaMs = 0;
+            if (!finished && _done > 0 && _total > _done)
+                etaMs = static_cast<long long>((_total - _done) * (double)elapsedMs / _done);
+
+            Robomongo::AppRegistry::instance().bus()->send(_receiver,
+                new Robomongo::OperationProgressEvent(_sender, _token, _description, _done, _total, perSecond, etaMs, finished));
+        }
+
+        QObject *const _sender;
+        QObject *const _receiver;
+        const Robomongo::OperationTokenPtr _token;
+        const std::string _description;
+        long long _done;
+        long long _total;
+        bool _isReported;
+        bool _isFinished;
+        QElapsedTimer _elapsed;
+        QElapsedTimer _lastReport;
+    };
+}
+
 namespace Robomongo
 {
-    MongoWorker::MongoWorker(ConnectionSettings *connection,bool isLoadMongoRcJs, int batchSize, QObject *parent) : QObject(parent),
+    struct MongoWorker::QueryCursor
+    {
+        QueryCursor(std::auto_ptr<mongo::DBClientCursor> cursor, const MongoQueryInfo &info) :
+            cursor(cursor),
+            info(info),
+            position(info._skip) { lastUsed.start(); }
+
+        boost::scoped_ptr<mongo::DBClientCursor> cursor;
+        MongoQueryInfo info;
+        int position; // number of documents already read from the cursor, including skipped
+        QElapsedTimer lastUsed;
+    };
+
+    MongoWorker::MongoWorker(ConnectionSettings *connection,bool isLoadMongoRcJs, int batchSize, bool hasScriptEngine, QObject *parent) : QObject(parent),
         _connection(connection),
         _scriptEngine(NULL),
         _dbclient(NULL),
         _isAdmin(true),
         _isLoadMongoRcJs(isLoadMongoRcJs),
         _batchSize(batchSize),
+        _hasScriptEngine(hasScriptEngine),
         _timerId(-1)
     {         
         _thread = new QThread(this);
@@ -60,6 +227,8 @@ namespace Robomongo
                 _scriptEngine->ping();
             }
 
+            releaseIdleQueryCursors();
+
         } catch(std::exception &ex) {
             LOG_MSG(ex.what(), mongo::LL_ERROR);
         }
@@ -68,10 +237,12 @@ namespace Robomongo
     void MongoWorker::init()
     {        
         try {
-            _scriptEngine = new ScriptEngine(_connection);
-            _scriptEngine->init(_isLoadMongoRcJs);
-            _scriptEngine->use(_connection->defaultDatabase());
-            _scriptEngine->setBatchSize(_batchSize);
+            if (_hasScriptEngine) {
+                _scriptEngine = new ScriptEngine(_connection);
+                _scriptEngine->init(_isLoadMongoRcJs);
+                _scriptEngine->use(_connection->defaultDatabase());
+                _scriptEngine->setBatchSize(_batchSize);
+            }
             _timerId = startTimer(pingTimeMs);
         }
         catch (const std::exception &ex) {
@@ -81,12 +252,19 @@ namespace Robomongo
 
     MongoWorker::~MongoWorker()
     {
-        delete _dbclient;
-        delete _connection;
+        // Worker thread is stopped first: cursors send killCursors on the same connection,
+        // that could still be used by the request handled by this thread
         _thread->quit();
-        if (!_thread->wait(2000))
+        if (!_thread->wait(2000)) {
             _thread->terminate();
+            _thread->wait();
+        }
 
+        for (QueryCursorsContainerType::const_iterator it = _queryCursors.begin(); it != _queryCursors.end(); ++it) {
+            delete it->second;
+        }
+        delete _dbclient;
+        delete _connection;
         delete _scriptEngine;
         delete _thread;
     }
@@ -99,19 +277,9 @@ namespace Robomongo
         QMutexLocker lock(&_firstConnectionMutex);
 
         try {
-            mongo::DBClientBase *conn = getConnection();
+            getConnection();
             bool hasPrimary = _connection->hasEnabledPrimaryCredential();
             if (hasPrimary) {
-                std::string errmsg;
-                bool ok = conn->auth(
-                    _connection->primaryCredential()->databaseName(),
-                    _connection->primaryCredential()->userName(),
-                    _connection->primaryCredential()->userPassword(), errmsg);
-
-                if (!ok) {
-                    throw std::runtime_error("Unable to authorize");
-                }
-
                 // If authentication succeed and database name is 'admin' -
                 // then user is admin, otherwise user is not admin
                 std::string dbName = _connection->primaryCredential()->databaseName();
@@ -185,16 +353,50 @@ namespace Robomongo
             boost::scoped_ptr<MongoClient> client(getClient());
 
             std::vector<std::string> stringList = client->getCollectionNames(event->databaseName());
-            const std::vector<MongoCollectionInfo> &infos = client->runCollStatsCommand(stringList);
-            client->done();
 
+            // Names are shown immediately, statistics are filled in by parts
+            std::vector<MongoCollectionInfo> infos;
+            for (std::vector<std::string>::const_iterator it = stringList.begin(); it != stringList.end(); ++it) {
+                infos.push_back(MongoCollectionInfo(MongoNamespace(*it)));
+            }
             reply(event->sender(), new LoadCollectionNamesResponse(this, event->databaseName(), infos));
+
+            if (event->loadStats())
+                loadCollectionStats(client.get(), event->sender(), event->databaseName(), stringList);
+            client->done();
         } catch(const mongo::DBException &ex) {
             reply(event->sender(), new LoadCollectionNamesResponse(this, EventError("Unable to load list of collections.")));
             LOG_MSG(ex.what(), mongo::LL_ERROR);
         }
     }
 
+    void MongoWorker::handle(LoadCollectionStatsRequest *event)
+    {
+        try {
+            boost::scoped_ptr<MongoClient> client(getClient());
+            loadCollectionStats(client.get(), event->sender(), event->databaseName(), event->namespaces());
+            client->done();
+        } catch(const mongo::DBException &ex) {
+            LOG_MSG(ex.what(), mongo::LL_ERROR);
+        }
+    }
+
+    void MongoWorker::loadCollectionStats(MongoClient *client, QObject *receiver, const std::string &databaseName,
+                                          const std::vector<std::string> &namespaces)
+    {
+        try {
+            for (size_t i = 0; i < namespaces.size(); i += collStatsPartSize) {
+                size_t end = std::min<size_t>(i + collStatsPartSize, namespaces.size());
+                std::vector<std::string> part(namespaces.begin() + i, namespaces.begin() + end);
+                const std::vector<MongoCollectionInfo> &stats = client->runCollStatsCommand(part);
+                reply(receiver, new LoadCollectionStatsResponse(this, databaseName, stats));
+            }
+        } catch(const mongo::DBException &ex) {
+            // Names are already shown, statistics are optional
+            LOG_MSG(ex.what(), mongo::LL_ERROR);
+        }
+    }
+
     void MongoWorker::handle(LoadUsersRequest *event)
     {
         try {
@@ -301,6 +503,57 @@ namespace Robomongo
         }
     }
 
+    void MongoWorker::handle(InsertDocumentsRequest *event)
+    {
+        const std::vector<mongo::BSONObj> &documents = event->documents();
+        long long inserted = 0;
+        std::vector<std::string> errors;
+        try {
+            // Single batch is not worth of progress in status bar
+            bool reportStart = documents.size() > MongoClient::insertBatchDocuments;
+            OperationProgressReporter progress(this, event->sender(), event->token(), "Inserting into " + event->ns().toString(), reportStart);
+            progress.checkCancelled();
+
+            boost::scoped_ptr<MongoClient> client(getClient());
+            client->insertDocuments(documents, event->ns(), inserted, errors, &progress);
+            client->done();
+            progress.finish();
+
+            if (errors.empty()) {
+                reply(event->sender(), new InsertDocumentsResponse(this, event->ns(), documents, inserted));
+                return;
+            }
+
+            std::string message = insertErrorMessage("Unable to insert some of documents.", inserted, documents.size(), errors);
+            reply(event->sender(), new InsertDocumentsResponse(this, event->ns(), documents, inserted, EventError(message)));
+            LOG_MSG(message, mongo::LL_ERROR);
+        } catch(const mongo::DBException &ex) {
+            if (OperationToken::isCancelledError(ex)) {
+                std::string message = insertErrorMessage("Inserting of documents was cancelled.", inserted, documents.size(), errors);
+                reply(event->sender(), new InsertDocumentsResponse(this, event->ns(), documents, inserted, EventError(message)));
+                LOG_MSG(message, mongo::LL_INFO);
+                return;
+            }
+            std::string message = insertErrorMessage(std::string("Unable to insert documents: ") + ex.what() + ".", inserted, documents.size(), errors);
+            reply(event->sender(), new InsertDocumentsResponse(this, event->ns(), documents, inserted, EventError(message)));
+            LOG_MSG(message, mongo::LL_ERROR);
+        }
+    }
+
+    void MongoWorker::handle(UpdateDocumentRequest *event)
+    {
+        try {
+            boost::scoped_ptr<MongoClient> client(getClient());
+            client->updateDocument(event->original(), event->edited(), event->ns(), event->checkConflicts());
+            client->done();
+
+            reply(event->sender(), new UpdateDocumentResponse(this, event->ns(), event->original(), event->edited()));
+        } catch(const mongo::DBException &ex) {
+            reply(event->sender(), new UpdateDocumentResponse(this, event->ns(), event->original(), event->edited(), EventError(ex.what())));
+            LOG_MSG(ex.what(), mongo::LL_ERROR);
+        }
+    }
+
     void MongoWorker::handle(RemoveDocumentRequest *event)
     {
         try {
@@ -316,26 +569,197 @@ namespace Robomongo
         }
     }
 
+    void MongoWorker::handle(RemoveDocumentsRequest *event)
+    {
+        try {
+            OperationProgressReporter progress(this, event->sender(), event->token(), "Removing from " + event->ns().toString(), false);
+            progress.checkCancelled();
+
+            boost::scoped_ptr<MongoClient> client(getClient());
+            long long removed = client->removeDocuments(event->ns(), event->ids(), &progress);
+            client->done();
+            progress.finish();
+
+            reply(event->sender(), new RemoveDocumentsResponse(this, event->ns(), event->ids(), removed));
+        } catch(const mongo::DBException &ex) {
+            if (OperationToken::isCancelledError(ex)) {
+                reply(event->sender(), new RemoveDocumentsResponse(this, event->ns(), event->ids(), 0, EventError("Removing of documents was cancelled.")));
+                LOG_MSG(ex.what(), mongo::LL_INFO);
+                return;
+            }
+            reply(event->sender(), new RemoveDocumentsResponse(this, event->ns(), event->ids(), 0, EventError("Unable to remove documents.")));
+            LOG_MSG(ex.what(), mongo::LL_ERROR);
+        }
+    }
+
     void MongoWorker::handle(ExecuteQueryRequest *event)
     {
         try {
             boost::scoped_ptr<MongoClient> client(getClient());
-            std::vector<MongoDocumentPtr> docs = client->query(event->queryInfo());
+            MongoQueryInfo info = event->queryInfo();
+            QueryCursorKey key(event->sender(), event->resultIndex());
+            std::vector<MongoDocumentPtr> docs;
+            bool isFirstPart = true;
+
+            // Progress is reported only for queries, that take longer than progressIntervalMs
+            OperationProgressReporter progress(this, event->sender(), event->token(), "Loading " + info._info._ns.toString(), false);
+            long long expected = info._limit > 0 ? info._limit : 0;
+            long long loaded = 0;
+
+            // Next page of the same results view continues reading from the cursor
+            // of the previous page, instead of skipping all previous documents again
+            std::auto_ptr<mongo::DBClientCursor> ownCursor;
+            QueryCursor *paging = NULL;
+            bool reused = false;
+            if (isPagingCursorSupported(info)) {
+                paging = pagingCursor(client.get(), key, info, reused);
+            } else {
+                releaseQueryCursor(key);
+                ownCursor = client->openCursor(info);
+            }
+
+            mongo::DBClientCursor *cursor = paging ? paging->cursor.get() : ownCursor.get();
+            size_t pageLeft = info._limit > 0 ? info._limit : std::numeric_limits<size_t>::max();
+            bool hasMore = cursor != NULL;
+
+            // Send documents as soon as every server batch arrives,
+            // so that first rows are shown after single round trip
+            while (hasMore && pageLeft > 0) {
+                try {
+                    hasMore = MongoClient::readPart(cursor, docs, std::min<size_t>(queryPartDocuments, pageLeft), queryPartBytes);
+                } catch(const mongo::DBException &) {
+                    // Reused cursor may be already closed by server, query once again
+                    if (!reused || !isFirstPart || docs.size())
+                        throw;
+
+                    reused = false;
+                    releaseQueryCursor(key);
+                    paging = pagingCursor(client.get(), key, info, reused);
+                    cursor = paging ? paging->cursor.get() : NULL;
+                    hasMore = cursor != NULL;
+                    continue;
+                }
+
+                pageLeft -= docs.size();
+                loaded += docs.size();
+                if (paging)
+                    paging->position += docs.size();
+
+                // Cancelled query shows documents, loaded so far
+                if (progress.isCancelled()) {
+                    hasMore = false;
+                    break;
+                }
+
+                progress.update(loaded, expected);
+                if (!hasMore || pageLeft == 0)
+                    break;
+
+                reply(event->sender(), new ExecuteQueryResponse(this, event->resultIndex(), info, docs, isFirstPart, false));
+                docs.clear();
+                isFirstPart = false;
+            }
+
+            if (paging) {
+                if (hasMore)
+                    paging->lastUsed.start();
+                else
+                    releaseQueryCursor(key);
+            }
             client->done();
+            progress.finish();
 
-            reply(event->sender(), new ExecuteQueryResponse(this, event->resultIndex(), event->queryInfo(), docs));
+            reply(event->sender(), new ExecuteQueryResponse(this, event->resultIndex(), info, docs, isFirstPart, true));
         } catch(const mongo::DBException &ex) {
+            releaseQueryCursor(QueryCursorKey(event->sender(), event->resultIndex()));
             reply(event->sender(), new ExecuteQueryResponse(this, EventError("Unable to complete query.")));
             LOG_MSG(ex.what(), mongo::LL_ERROR);
         }
     }
 
+    void MongoWorker::handle(ReleaseQueryCursorsRequest *event)
+    {
+        try {
+            releaseQueryCursors(event->sender());
+        } catch(const mongo::DBException &ex) {
+            LOG_MSG(ex.what(), mongo::LL_ERROR);
+        }
+    }
+
+    MongoWorker::QueryCursor *MongoWorker::pagingCursor(MongoClient *client, const QueryCursorKey &key, const MongoQueryInfo &info, bool &reused)
+    {
+        QueryCursorsContainerType::iterator it = _queryCursors.find(key);
+        if (it != _queryCursors.end()) {
+            QueryCursor *cached = it->second;
+            if (isSameQuery(cached->info, info) && cached->position == info._skip
+                && cached->cursor.get() && !cached->cursor->isDead() && !cached->lastUsed.hasExpired(queryCursorIdleTimeoutMs)) {
+                reused = true;
+                return cached;
+            }
+
+            // Moving backwards or query was changed
+            delete cached;
+            _queryCursors.erase(it);
+        }
+
+        // Server should not limit cursor, page size is controlled while reading
+        MongoQueryInfo cursorInfo(info);
+        cursorInfo._limit = 0;
+
+        std::auto_ptr<mongo::DBClientCursor> opened = client->openCursor(cursorInfo);
+        reused = false;
+        if (!opened.get())
+            return NULL;
+
+        QueryCursor *cursor = new QueryCursor(opened, info);
+        _queryCursors[key] = cursor;
+        return cursor;
+    }
+
+    void MongoWorker::releaseQueryCursor(const QueryCursorKey &key)
+    {
+        QueryCursorsContainerType::iterator it = _queryCursors.find(key);
+        if (it == _queryCursors.end())
+            return;
+
+        QueryCursor *cursor = it->second;
+        _queryCursors.erase(it);
+        delete cursor;
+    }
+
+    void MongoWorker::releaseQueryCursors(QObject *receiver)
+    {
+        QueryCursorsContainerType::iterator it = _queryCursors.begin();
+        while (it != _queryCursors.end()) {
+            if (it->first.first == receiver) {
+                delete it->second;
+                _queryCursors.erase(it++);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    void MongoWorker::releaseIdleQueryCursors()
+    {
+        QueryCursorsContainerType::iterator it = _queryCursors.begin();
+        while (it != _queryCursors.end()) {
+            if (it->second->lastUsed.hasExpired(queryCursorIdleTimeoutMs)) {
+                delete it->second;
+                _queryCursors.erase(it++);
+            } else {
+                ++it;
+            }
+        }
+    }
+
     /**
      * @brief Execute javascript
      */
     void MongoWorker::handle(ExecuteScriptRequest *event)
     {
         try {
+            _scriptEngine->switchScope(event->sender());
             MongoShellExecResult result = _scriptEngine->exec(event->script, event->databaseName);
             reply(event->sender(), new ExecuteScriptResponse(this, result, event->script.empty()));
         } catch(const mongo::DBException &ex) {
@@ -344,9 +768,30 @@ namespace Robomongo
         }
     }
 
+    void MongoWorker::handle(CreateScriptScopeRequest *event)
+    {
+        try {
+            if (_scriptEngine)
+                _scriptEngine->switchScope(event->sender(), event->defaultDatabase);
+        } catch(const mongo::DBException &ex) {
+            LOG_MSG(ex.what(), mongo::LL_ERROR);
+        }
+    }
+
+    void MongoWorker::handle(ReleaseScriptScopeRequest *event)
+    {
+        try {
+            if (_scriptEngine)
+                _scriptEngine->releaseScope(event->sender());
+        } catch(const mongo::DBException &ex) {
+            LOG_MSG(ex.what(), mongo::LL_ERROR);
+        }
+    }
+
     void MongoWorker::handle(AutocompleteRequest *event)
     {
         try {
+            _scriptEngine->switchScope(event->sender());
             QStringList list = _scriptEngine->complete(event->prefix, event->mode);
             reply(event->sender(), new AutocompleteResponse(this, list, event->prefix));
         } catch(const mongo::DBException &ex) {
@@ -372,12 +817,22 @@ namespace Robomongo
     void MongoWorker::handle(DropDatabaseRequest *event)
     {
         try {
+            // dropDatabase is single server command: it can be cancelled only while it waits in the queue
+            OperationProgressReporter progress(this, event->sender(), event->token(), "Dropping database " + event->database(), true);
+            progress.checkCancelled();
+
             boost::scoped_ptr<MongoClient> client(getClient());
             client->dropDatabase(event->database());
             client->done();
+            progress.finish();
 
             reply(event->sender(), new DropDatabaseResponse(this));
         } catch(const mongo::DBException &ex) {
+            if (OperationToken::isCancelledError(ex)) {
+                reply(event->sender(), new DropDatabaseResponse(this, EventError("Dropping of database was cancelled.")));
+                LOG_MSG(ex.what(), mongo::LL_INFO);
+                return;
+            }
             reply(event->sender(), new DropDatabaseResponse(this, EventError("Unable to drop database.")));
             LOG_MSG(ex.what(), mongo::LL_ERROR);
         }
@@ -428,12 +883,22 @@ namespace Robomongo
     void MongoWorker::handle(DuplicateCollectionRequest *event)
     {
         try {
+            MongoNamespace to(event->ns().databaseName(), event->newCollection());
+            OperationProgressReporter progress(this, event->sender(), event->token(), "Duplicating to " + to.toString(), true);
+            progress.checkCancelled();
+
             boost::scoped_ptr<MongoClient> client(getClient());
-            client->duplicateCollection(event->ns(), event->newCollection());
+            client->duplicateCollection(event->ns(), event->newCollection(), &progress);
             client->done();
+            progress.finish();
 
             reply(event->sender(), new DuplicateCollectionResponse(this));
         } catch(const mongo::DBException &ex) {
+            if (OperationToken::isCancelledError(ex)) {
+                reply(event->sender(), new DuplicateCollectionResponse(this, EventError("Duplicating of collection was cancelled.")));
+                LOG_MSG(ex.what(), mongo::LL_INFO);
+                return;
+            }
             reply(event->sender(), new DuplicateCollectionResponse(this, EventError("Unable to duplicate collection.")));
             LOG_MSG(ex.what(), mongo::LL_ERROR);
         }
@@ -442,13 +907,26 @@ namespace Robomongo
     void MongoWorker::handle(CopyCollectionToDiffServerRequest *event)
     {
         try {
+            OperationProgressReporter progress(this, event->sender(), event->token(), "Copying to " + event->to().toString(), true);
+            progress.checkCancelled();
+
+            // Connection of source worker is used by its own thread,
+            // so documents are read through separate connection
+            boost::scoped_ptr<ConnectionSettings> sourceSettings(event->worker()->connectionRecord()->clone());
+            boost::scoped_ptr<mongo::DBClientConnection> source(openConnection(sourceSettings.get()));
+
             boost::scoped_ptr<MongoClient> client(getClient());
-            MongoWorker *cl = event->worker();
-            client->copyCollectionToDiffServer(cl->_dbclient,event->from(),event->to());
+            client->copyCollectionToDiffServer(source.get(), event->from(), event->to(), &progress);
             client->done();
+            progress.finish();
 
             reply(event->sender(), new CopyCollectionToDiffServerResponse(this));
         } catch(const mongo::DBException &ex) {
+            if (OperationToken::isCancelledError(ex)) {
+                reply(event->sender(), new CopyCollectionToDiffServerResponse(this, EventError("Copying of collection was cancelled.")));
+                LOG_MSG(ex.what(), mongo::LL_INFO);
+                return;
+            }
             reply(event->sender(), new CopyCollectionToDiffServerResponse(this, EventError("Unable to copy collection.")));
             LOG_MSG(ex.what(), mongo::LL_ERROR);
         }
@@ -513,13 +991,32 @@ namespace Robomongo
     mongo::DBClientConnection *MongoWorker::getConnection()
     {
         if (!_dbclient) {
-            mongo::DBClientConnection *conn = new mongo::DBClientConnection(true);
-            conn->connect(_connection->info());
-            _dbclient = conn;
+            _dbclient = openConnection(_connection);
         }
         return _dbclient;
     }
 
+    mongo::DBClientConnection *MongoWorker::openConnection(ConnectionSettings *connection)
+    {
+        std::auto_ptr<mongo::DBClientConnection> conn(new mongo::DBClientConnection(true));
+        conn->connect(connection->info());
+
+        // Every worker of the server has its own connection, so
+        // every connection should be authorized separately
+        if (connection->hasEnabledPrimaryCredential()) {
+            std::string errmsg;
+            bool ok = conn->auth(
+                connection->primaryCredential()->databaseName(),
+                connection->primaryCredential()->userName(),
+                connection->primaryCredential()->userPassword(), errmsg);
+
+            if (!ok) {
+                throw mongo::UserException(0, "Unable to authorize");
+            }
+        }
+        return conn.release();
+    }
+
     MongoClient *MongoWorker::getClient()
     {
         return new MongoClient(getConnection());
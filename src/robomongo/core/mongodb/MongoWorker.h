@@ -2,6 +2,7 @@
 
 #include <QObject>
 #include <QMutex>
+#include <map>
 
 #include "robomongo/core/events/MongoEvents.h"
 
@@ -23,10 +24,34 @@ namespace Robomongo
 
     public:
         typedef std::vector<std::string> DatabasesContainerType;
-        explicit MongoWorker(ConnectionSettings *connection, bool isLoadMongoRcJs, int batchSize, QObject *parent = NULL);
+        /**
+         * @param hasScriptEngine: ScriptEngine is created only for worker, that executes scripts.
+         */
+        explicit MongoWorker(ConnectionSettings *connection, bool isLoadMongoRcJs, int batchSize, bool hasScriptEngine = true, QObject *parent = NULL);
         ConnectionSettings *connectionRecord() const {return _connection;}
         ~MongoWorker();
         enum{pingTimeMs = 60*1000};
+
+        /**
+         * @brief Limits of single part of streamed query results.
+         */
+        enum{queryPartDocuments = 100, queryPartBytes = 4*1024*1024};
+
+        /**
+         * @brief Paging cursors, not used during this time, are closed.
+         * MongoDB server itself times out idle cursors after 10 minutes.
+         */
+        enum{queryCursorIdleTimeoutMs = 9*60*1000};
+
+        /**
+         * @brief Number of pipelined collStats commands, answered by single response event.
+         */
+        enum{collStatsPartSize = 50};
+
+        /**
+         * @brief Minimal interval between progress events of long running operations.
+         */
+        enum{progressIntervalMs = 500};
         
     protected Q_SLOTS: // handlers:
         void init();
@@ -51,6 +76,11 @@ namespace Robomongo
          */
         void handle(LoadCollectionNamesRequest *event);
 
+        /**
+         * @brief Load statistics of specified collections
+         */
+        void handle(LoadCollectionStatsRequest *event);
+
         /**
          * @brief Load list of all users
          */
@@ -86,21 +116,51 @@ namespace Robomongo
          */
         void handle(InsertDocumentRequest *event);
 
+        /**
+         * @brief Inserts documents in batches, reports progress per batch
+         */
+        void handle(InsertDocumentsRequest *event);
+
+        /**
+         * @brief Saves changed fields of edited document
+         */
+        void handle(UpdateDocumentRequest *event);
+
         /**
          * @brief Remove documents
          */
         void handle(RemoveDocumentRequest *event);
 
+        /**
+         * @brief Removes documents by _id with $in queries
+         */
+        void handle(RemoveDocumentsRequest *event);
+
         /**
          * @brief Load list of all collection names
          */
         void handle(ExecuteQueryRequest *event);
 
+        /**
+         * @brief Close paging cursors of results view
+         */
+        void handle(ReleaseQueryCursorsRequest *event);
+
         /**
          * @brief Execute javascript
          */
         void handle(ExecuteScriptRequest *event);
 
+        /**
+         * @brief Create JavaScript scope of opened shell
+         */
+        void handle(CreateScriptScopeRequest *event);
+
+        /**
+         * @brief Delete JavaScript scope of closed shell
+         */
+        void handle(ReleaseScriptScopeRequest *event);
+
         void handle(AutocompleteRequest *event);
         void handle(CreateDatabaseRequest *event);
         void handle(DropDatabaseRequest *event);
@@ -128,10 +188,42 @@ namespace Robomongo
         DatabasesContainerType getDatabaseNamesSafe();
         std::string getAuthBase() const;
 
+        /**
+         * @brief Loads collStats by parts of collStatsPartSize, every part is replied
+         * to 'receiver' as LoadCollectionStatsResponse.
+         */
+        void loadCollectionStats(MongoClient *client, QObject *receiver, const std::string &databaseName,
+                                 const std::vector<std::string> &namespaces);
+
         mongo::DBClientConnection *_dbclient;
         mongo::DBClientConnection *getConnection();
+
+        /**
+         * @brief Opens new authorized connection, that is owned by caller.
+         */
+        static mongo::DBClientConnection *openConnection(ConnectionSettings *connection);
         MongoClient *getClient();
 
+        /**
+         * @brief Server-side cursor, kept open between pages of results view.
+         * Key is (receiver of results, result index).
+         */
+        struct QueryCursor;
+        typedef std::pair<QObject *, int> QueryCursorKey;
+        typedef std::map<QueryCursorKey, QueryCursor *> QueryCursorsContainerType;
+
+        /**
+         * @brief Returns cursor, positioned at info._skip document of the query.
+         * Cursor of the previous page is reused, if it stopped exactly there,
+         * otherwise new cursor is opened (with skip).
+         * Returns NULL, if cursor can't be opened (it is not cached then).
+         */
+        QueryCursor *pagingCursor(MongoClient *client, const QueryCursorKey &key, const MongoQueryInfo &info, bool &reused);
+        void releaseQueryCursor(const QueryCursorKey &key);
+        void releaseQueryCursors(QObject *receiver);
+        void releaseIdleQueryCursors();
+        QueryCursorsContainerType _queryCursors;
+
         /**
          * @brief Send reply event to object 'obj'
          */
@@ -144,6 +236,7 @@ namespace Robomongo
         bool _isAdmin;
         const bool _isLoadMongoRcJs;
         const int _batchSize;
+        const bool _hasScriptEngine;
         int _timerId;
 
         ConnectionSettings *_connection;
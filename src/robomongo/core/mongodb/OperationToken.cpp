@@ -0,0 +1,33 @@
+#include "robomongo/core/mongodb/OperationToken.h"
+
+#include <mongo/util/assert_util.h>
+
+namespace Robomongo
+{
+    OperationToken::OperationToken() :
+        _cancelled(0)
+    {
+    }
+
+    void OperationToken::cancel()
+    {
+        _cancelled.fetchAndStoreOrdered(1);
+    }
+
+    bool OperationToken::isCancelled() const
+    {
+        // Qt4 and Qt5 compatible atomic read
+        return _cancelled.fetchAndAddOrdered(0) != 0;
+    }
+
+    void OperationToken::checkCancelled() const
+    {
+        if (isCancelled())
+            throw mongo::UserException(cancelledErrorCode, "Operation was cancelled");
+    }
+
+    bool OperationToken::isCancelledError(const mongo::DBException &ex)
+    {
+        return ex.getCode() == cancelledErrorCode;
+    }
+}
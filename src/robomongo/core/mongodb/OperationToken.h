@@ -0,0 +1,58 @@
+#pragma once
+
+#include <QAtomicInt>
+
+#include "robomongo/core/Core.h"
+
+namespace mongo
+{
+    class DBException;
+}
+
+namespace Robomongo
+{
+    /**
+     * @brief Shared between requester and MongoWorker, which executes long running
+     * operation. Requester (or UI) cancels the operation from its own thread, worker
+     * checks the token between parts of the work (i.e. between server batches).
+     * Scripts are interrupted by ScriptEngine::interrupt(), not by this token.
+     */
+    class OperationToken
+    {
+    public:
+        /**
+         * @brief Code of exception, thrown by checkCancelled().
+         */
+        enum{cancelledErrorCode = 17900};
+
+        OperationToken();
+
+        void cancel();
+        bool isCancelled() const;
+
+        /**
+         * @throws mongo::UserException with cancelledErrorCode, if operation is cancelled.
+         */
+        void checkCancelled() const;
+
+        static bool isCancelledError(const mongo::DBException &ex);
+
+    private:
+        mutable QAtomicInt _cancelled;
+    };
+
+    typedef boost::shared_ptr<OperationToken> OperationTokenPtr;
+
+    /**
+     * @brief Receives progress of long running operation.
+     * May throw to abort the operation (i.e. when it is cancelled).
+     */
+    class OperationProgressListener
+    {
+    public:
+        virtual void progress(long long done, long long total) = 0;
+
+    protected:
+        ~OperationProgressListener() {}
+    };
+}
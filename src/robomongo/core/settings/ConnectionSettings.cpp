@@ -95,6 +95,15 @@ namespace Robomongo
         }
     }
 
+    bool ConnectionSettings::isSameConnection(const ConnectionSettings *other) const
+    {
+        QVariantMap map = toVariant().toMap();
+        QVariantMap otherMap = other->toVariant().toMap();
+        map.remove("defaultDatabase");
+        otherMap.remove("defaultDatabase");
+        return map == otherMap;
+    }
+
     /**
      * @brief Converts to QVariantMap
      */
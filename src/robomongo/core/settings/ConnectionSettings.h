@@ -43,6 +43,12 @@ namespace Robomongo
          */
         QVariant toVariant() const;
 
+        /**
+         * @brief Returns true, if 'other' connects to the same server with the same
+         * credentials (default database is not compared).
+         */
+        bool isSameConnection(const ConnectionSettings *other) const;
+
         /**
          * @brief Name of connection
          */
@@ -44,7 +44,10 @@ namespace Robomongo
         _viewMode(Robomongo::Tree),
         _autocompletionMode(AutocompleteAll),
         _batchSize(50),
-        _disableConnectionShortcuts(false)
+        _connectionsPerServer(4),
+        _disableConnectionShortcuts(false),
+        _lazyCollectionStats(false),
+        _checkEditConflicts(false)
     {
         load();
         LOG_MSG("SettingsManager initialized in " + _configPath, mongo::LL_INFO, false);
@@ -151,6 +154,8 @@ namespace Robomongo
         _timeZone = (SupportedTimes) timeZone;
         _loadMongoRcJs = map.value("loadMongoRcJs").toBool();
         _disableConnectionShortcuts = map.value("disableConnectionShortcuts").toBool();
+        _lazyCollectionStats = map.value("lazyCollectionStats").toBool();
+        _checkEditConflicts = map.value("checkEditConflicts").toBool();
 
         // Load AutocompletionMode
         if (map.contains("autocompletionMode")) {
@@ -166,6 +171,11 @@ namespace Robomongo
         _batchSize = map.value("batchSize").toInt();
         if (_batchSize == 0)
             _batchSize = 50;
+
+        // Load number of connections per server
+        _connectionsPerServer = map.value("connectionsPerServer").toInt();
+        if (_connectionsPerServer <= 0)
+            _connectionsPerServer = 4;
         _currentStyle = map.value("style").toString();
         if (_currentStyle.isEmpty()) {
             _currentStyle = AppStyle::StyleName;
@@ -227,10 +237,14 @@ namespace Robomongo
 
         // 7. Save disableConnectionShortcuts
         map.insert("disableConnectionShortcuts", _disableConnectionShortcuts);
+        map.insert("lazyCollectionStats", _lazyCollectionStats);
+        map.insert("checkEditConflicts", _checkEditConflicts);
         
         // 8. Save batchSize
         map.insert("batchSize", _batchSize);
 
+        map.insert("connectionsPerServer", _connectionsPerServer);
+
         // 9. Save style
         map.insert("style", _currentStyle);
 
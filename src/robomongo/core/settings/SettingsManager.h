@@ -98,6 +98,25 @@ namespace Robomongo
         void setBatchSize(int batchSize) { _batchSize = batchSize; }
         int batchSize() const { return _batchSize; }
 
+        /**
+         * @brief Load statistics only for collections, visible in explorer.
+         */
+        void setLazyCollectionStats(bool isLazy) { _lazyCollectionStats = isLazy; }
+        bool lazyCollectionStats() const { return _lazyCollectionStats; }
+
+        /**
+         * @brief Save edited document only if fields, changed by user, still have
+         * their original values on server.
+         */
+        void setCheckEditConflicts(bool isCheck) { _checkEditConflicts = isCheck; }
+        bool checkEditConflicts() const { return _checkEditConflicts; }
+
+        /**
+         * @brief Number of connections (and worker threads) opened for every server.
+         */
+        void setConnectionsPerServer(int count) { _connectionsPerServer = count; }
+        int connectionsPerServer() const { return _connectionsPerServer; }
+
         QString currentStyle() const {return _currentStyle; }
         void setCurrentStyle(const QString& style);
 
@@ -134,7 +153,10 @@ namespace Robomongo
         bool _autoExec;
         bool _lineNumbers;
         bool _disableConnectionShortcuts;
+        bool _lazyCollectionStats;
+        bool _checkEditConflicts;
         int _batchSize;
+        int _connectionsPerServer;
         QString _currentStyle;
         /**
          * @brief List of connections
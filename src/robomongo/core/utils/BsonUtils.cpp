@@ -1,5 +1,9 @@
 #include "robomongo/core/utils/BsonUtils.h"
 
+#include <algorithm>
+#include <clocale>
+#include <cstdio>
+#include <cstring>
 #include <mongo/client/dbclient.h>
 #include <mongo/bson/bsonobjiterator.h>
 #include "robomongo/core/utils/QtUtils.h"
@@ -8,6 +12,252 @@
 #include "robomongo/shell/db/ptimeutil.h"
 
 using namespace mongo;
+
+namespace
+{
+    /**
+     * @brief Indentation of 16 levels (4 spaces per level), deeper levels are appended in parts.
+     */
+    const char indentation[] = "                                                                ";
+
+    void appendIndent(std::string &out, int levels)
+    {
+        size_t count = levels > 0 ? levels * 4 : 0;
+        while (count > 0) {
+            size_t part = std::min(count, sizeof(indentation) - 1);
+            out.append(indentation, part);
+            count -= part;
+        }
+    }
+
+    void appendUnsigned(std::string &out, unsigned long long value)
+    {
+        char buffer[24];
+        char *end = buffer + sizeof(buffer);
+        char *digits = end;
+        do {
+            *--digits = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value);
+        out.append(digits, end - digits);
+    }
+
+    void appendInteger(std::string &out, long long value)
+    {
+        if (value < 0) {
+            out.push_back('-');
+            appendUnsigned(out, 0ULL - static_cast<unsigned long long>(value));
+        }
+        else {
+            appendUnsigned(out, static_cast<unsigned long long>(value));
+        }
+    }
+
+    /**
+     * @brief Formats double with printf 'format', always with '.' as decimal point
+     * (like classic locale of streams, while C locale may be changed by Qt).
+     */
+    void appendDouble(std::string &out, const char *format, double value)
+    {
+        // Enough for "%.16f" of the largest double (309 integer digits)
+        char buffer[352];
+        int length = snprintf(buffer, sizeof(buffer), format, value);
+        if (length < 0)
+            return;
+        length = std::min(length, static_cast<int>(sizeof(buffer)) - 1);
+
+        const char *point = localeconv()->decimal_point;
+        size_t pointLength = strlen(point);
+        const char *found = (pointLength == 1 && *point == '.') ? NULL : strstr(buffer, point);
+        if (!found || !pointLength) {
+            out.append(buffer, length);
+            return;
+        }
+
+        out.append(buffer, found - buffer);
+        out.push_back('.');
+        out.append(found + pointLength, buffer + length - found - pointLength);
+    }
+
+    const char hexDigits[] = "0123456789abcdef";
+
+    void appendHex(std::string &out, const unsigned char *data, size_t size)
+    {
+        for (size_t i = 0; i < size; ++i) {
+            out.push_back(hexDigits[data[i] >> 4]);
+            out.push_back(hexDigits[data[i] & 0xF]);
+        }
+    }
+
+    /**
+     * @brief Lowercase hex, at least two digits.
+     */
+    void appendTypeHex(std::string &out, unsigned int value)
+    {
+        char buffer[16];
+        char *end = buffer + sizeof(buffer);
+        char *digits = end;
+        do {
+            *--digits = hexDigits[value & 0xF];
+            value >>= 4;
+        } while (value);
+        if (end - digits < 2)
+            *--digits = '0';
+        out.append(digits, end - digits);
+    }
+
+    /**
+     * @brief Appends JSON-escaped string. Runs of characters, that need no
+     * escaping (including all non-ASCII bytes), are appended at once.
+     */
+    void appendEscaped(std::string &out, const char *data, size_t size, bool escapeSlash)
+    {
+        const char *run = data;
+        const char *end = data + size;
+        for (const char *it = data; it != end; ++it) {
+            unsigned char ch = static_cast<unsigned char>(*it);
+            if (ch > 0x1f && ch != '"' && ch != '\\' && (ch != '/' || !escapeSlash))
+                continue;
+
+            out.append(run, it - run);
+            run = it + 1;
+
+            switch (ch) {
+            case '"':
+                out.append("\\\"");
+                break;
+            case '\\':
+                out.append("\\\\");
+                break;
+            case '/':
+                out.append("\\/");
+                break;
+            case '\b':
+                out.append("\\b");
+                break;
+            case '\f':
+                out.append("\\f");
+                break;
+            case '\n':
+                out.append("\\n");
+                break;
+            case '\r':
+                out.append("\\r");
+                break;
+            case '\t':
+                out.append("\\t");
+                break;
+            default:
+                out.append("\\u00");
+                out.push_back(hexDigits[ch >> 4]);
+                out.push_back(hexDigits[ch & 0xF]);
+                break;
+            }
+        }
+        out.append(run, end - run);
+    }
+
+    /**
+     * @brief Tests whether elements have the same type and the same bytes of value
+     * (unlike woCompare, 1 and 1.0 are different values here).
+     */
+    bool isBinaryEqualValue(const BSONElement &first, const BSONElement &second)
+    {
+        return first.type() == second.type()
+            && first.valuesize() == second.valuesize()
+            && memcmp(first.value(), second.value(), first.valuesize()) == 0;
+    }
+
+    bool isPathFieldName(const char *name)
+    {
+        return name[0] != '\0' && name[0] != '$' && strchr(name, '.') == NULL;
+    }
+
+    /**
+     * @brief Tests whether fields of 'edited' can be produced from fields of 'original'
+     * with $set and $unset: names can be used in paths, common fields keep their order
+     * and new fields follow them in ascending order (as $set appends them).
+     */
+    bool isUpdatableLevel(const BSONObj &original, const BSONObj &edited)
+    {
+        BSONObjIterator originalIt(original);
+        while (originalIt.more()) {
+            if (!isPathFieldName(originalIt.next().fieldName()))
+                return false;
+        }
+
+        BSONObjIterator commonIt(original);
+        const char *lastNewField = NULL;
+        BSONObjIterator editedIt(edited);
+        while (editedIt.more()) {
+            BSONElement elem = editedIt.next();
+            if (!isPathFieldName(elem.fieldName()))
+                return false;
+
+            if (original.getField(elem.fieldName()).eoo()) {
+                if (lastNewField && strcmp(lastNewField, elem.fieldName()) >= 0)
+                    return false;
+                lastNewField = elem.fieldName();
+                continue;
+            }
+
+            if (lastNewField)
+                return false;
+
+            // Skip removed fields of original, common field should be next
+            while (true) {
+                if (!commonIt.more())
+                    return false;
+                BSONElement old = commonIt.next();
+                if (strcmp(old.fieldName(), elem.fieldName()) == 0)
+                    break;
+                if (!edited.getField(old.fieldName()).eoo())
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    void appendUpdate(const BSONObj &original, const BSONObj &edited, const std::string &prefix,
+                      BSONObjBuilder &set, BSONObjBuilder &unset, BSONObjBuilder &matchOriginal)
+    {
+        BSONObjIterator editedIt(edited);
+        while (editedIt.more()) {
+            BSONElement elem = editedIt.next();
+            BSONElement old = original.getField(elem.fieldName());
+            std::string path = prefix + elem.fieldName();
+
+            if (old.eoo()) {
+                set.appendAs(elem, path);
+                matchOriginal.append(path, BSON("$exists" << false));
+                continue;
+            }
+
+            if (isBinaryEqualValue(old, elem))
+                continue;
+
+            if (old.type() == Object && elem.type() == Object && isUpdatableLevel(old.Obj(), elem.Obj())) {
+                appendUpdate(old.Obj(), elem.Obj(), path + ".", set, unset, matchOriginal);
+                continue;
+            }
+
+            set.appendAs(elem, path);
+            matchOriginal.appendAs(old, path);
+        }
+
+        BSONObjIterator originalIt(original);
+        while (originalIt.more()) {
+            BSONElement old = originalIt.next();
+            if (!edited.getField(old.fieldName()).eoo())
+                continue;
+
+            std::string path = prefix + old.fieldName();
+            unset.append(path, "");
+            matchOriginal.appendAs(old, path);
+        }
+    }
+}
+
 namespace Robomongo
 {
     namespace BsonUtils
@@ -57,184 +307,162 @@ namespace Robomongo
             }
         }
 
-        std::string jsonString(const BSONObj &obj, JsonStringFormat format, int pretty, UUIDEncoding uuidEncoding, SupportedTimes timeFormat, bool isArray)
+        void appendJsonString(std::string &out, const BSONObj &obj, JsonStringFormat format, int pretty, UUIDEncoding uuidEncoding, SupportedTimes timeFormat, bool isArray)
         {
-            if ( obj.isEmpty() ) return isArray? "[]" : "{}";           
+            if ( obj.isEmpty() ) {
+                out.append(isArray ? "[]" : "{}");
+                return;
+            }
 
-            StringBuilder s;
-            s << (isArray ? "[" : "{");
+            out.push_back(isArray ? '[' : '{');
             BSONObjIterator i(obj);
             BSONElement e = i.next();
-            if ( !e.eoo() ){
-                while ( 1 ) {
-                    if ( pretty ) {
-                        s << '\n';
-                        for( int x = 0; x < pretty; x++ ){
-                            s << "    ";
-                        }
-                    }
-                    else {
-                        s << " ";
-                    }
-                    s << jsonString(e, format, true, pretty?pretty+1:0, uuidEncoding, timeFormat, isArray);
-                    e = i.next();
-
-                    if (e.eoo()) {
-                        s << '\n';
-                        for( int x = 0; x < pretty - 1; x++ ){
-                            s << "    ";
-                        }
-                        s << (isArray ? "]" : "}");
-                        break;
-                    }
+            while ( 1 ) {
+                if ( pretty ) {
+                    out.push_back('\n');
+                    appendIndent(out, pretty);
+                }
+                else {
+                    out.push_back(' ');
+                }
+                appendJsonString(out, e, format, true, pretty?pretty+1:0, uuidEncoding, timeFormat, isArray);
+                e = i.next();
 
-                    s << ",";
+                if (e.eoo()) {
+                    out.push_back('\n');
+                    appendIndent(out, pretty - 1);
+                    out.push_back(isArray ? ']' : '}');
+                    break;
                 }
+
+                out.push_back(',');
             }
-            return s.str();
         }
 
-        std::string jsonString(const BSONElement &elem, JsonStringFormat format, bool includeFieldNames, int pretty, UUIDEncoding uuidEncoding, SupportedTimes timeFormat, bool isArray)
+        void appendJsonString(std::string &out, const BSONElement &elem, JsonStringFormat format, bool includeFieldNames, int pretty, UUIDEncoding uuidEncoding, SupportedTimes timeFormat, bool isArray)
         {
-            BSONType t = elem.type();            
+            BSONType t = elem.type();
 
-            stringstream s;
-            if ( includeFieldNames && !isArray)
-                s << '"' << escape( elem.fieldName() ) << "\" : ";
+            if ( includeFieldNames && !isArray) {
+                out.push_back('"');
+                appendEscaped(out, elem.fieldName(), strlen(elem.fieldName()), false);
+                out.append("\" : ");
+            }
 
             switch ( t ) {
             case Undefined:
-                s << "undefined";
+                out.append("undefined");
                 break;
             case mongo::String:
             case Symbol:
-                s << '"' << escape( string(elem.valuestr(), elem.valuestrsize()-1) ) << '"';
+                out.push_back('"');
+                appendEscaped(out, elem.valuestr(), elem.valuestrsize()-1, false);
+                out.push_back('"');
                 break;
             case NumberLong:
-                s << "NumberLong(" << elem._numberLong() << ")";
+                out.append("NumberLong(");
+                appendInteger(out, elem._numberLong());
+                out.push_back(')');
                 break;
             case NumberInt:
-				s << elem.number();
-				break;
+                // Shortest form with 6 significant digits, as default stream formatting of double
+                appendDouble(out, "%g", elem.number());
+                break;
             case NumberDouble:
                 {
                     int sign=0;
                     if ( elem.number() >= -numeric_limits< double >::max() &&
                             elem.number() <= numeric_limits< double >::max() ) {
-                        s.precision( 16 );
-                        s << fixed << elem._numberDouble();
+                        appendDouble(out, "%.16f", elem._numberDouble());
                     }
                     else if ( mongo::isNaN(elem.number()) ) {
-                        s << "NaN";
+                        out.append("NaN");
                     }
                     else if ( mongo::isInf(elem.number(), &sign) ) {
-                        s << ( sign == 1 ? "Infinity" : "-Infinity");
-                    }
-                    else {
-                        StringBuilder ss;
-                        ss << "NumberDouble " << elem.number() << " cannot be represented in JSON";
-                        string message = ss.str();
-                        //massert( 10311 ,  message.c_str(), false );
+                        out.append( sign == 1 ? "Infinity" : "-Infinity");
                     }
                     break;
                 }
             case mongo::Bool:
-                s << ( elem.boolean() ? "true" : "false" );
+                out.append( elem.boolean() ? "true" : "false" );
                 break;
             case jstNULL:
-                s << "null";
+                out.append("null");
                 break;
-            case Object: {
-                BSONObj obj = elem.embeddedObject();
-                s << jsonString(obj, format, pretty, uuidEncoding,timeFormat);
-                }
+            case Object:
+                appendJsonString(out, elem.embeddedObject(), format, pretty, uuidEncoding, timeFormat);
                 break;
             case mongo::Array: {
-                if ( elem.embeddedObject().isEmpty() ) {
-                    s << "[]";
+                BSONObj array = elem.embeddedObject();
+                if ( array.isEmpty() ) {
+                    out.append("[]");
                     break;
                 }
-                s << "[ ";
-                BSONObjIterator i( elem.embeddedObject() );
+                out.append("[ ");
+                BSONObjIterator i( array );
                 BSONElement e = i.next();
-                if ( !e.eoo() ) {
-                    int count = 0;
-                    while ( 1 ) {
-                        if( pretty ) {
-                            s << '\n';
-                            for( int x = 0; x < pretty; x++ )
-                                s << "    ";
-                        }
+                int count = 0;
+                while ( 1 ) {
+                    if( pretty ) {
+                        out.push_back('\n');
+                        appendIndent(out, pretty);
+                    }
 
-                        if (strtol(e.fieldName(), 0, 10) > count) {
-                            s << "undefined";
-                        }
-                        else {
-                            s << jsonString(e, format, false, pretty?pretty+1:0, uuidEncoding, timeFormat, true);
-                            e = i.next();
-                        }
-                        count++;
-                        if ( e.eoo() ) {
-                            s << '\n';
-                            for( int x = 0; x < pretty - 1; x++ )
-                                s << "    ";
-                            s << "]";
-                            break;
-                        }
-                        s << ", ";
+                    if (strtol(e.fieldName(), 0, 10) > count) {
+                        out.append("undefined");
+                    }
+                    else {
+                        appendJsonString(out, e, format, false, pretty?pretty+1:0, uuidEncoding, timeFormat, true);
+                        e = i.next();
                     }
+                    count++;
+                    if ( e.eoo() ) {
+                        out.push_back('\n');
+                        appendIndent(out, pretty - 1);
+                        out.push_back(']');
+                        break;
+                    }
+                    out.append(", ");
                 }
-                //s << " ]";
                 break;
             }
             case DBRef: {
-                mongo::OID *x = (mongo::OID *) (elem.valuestr() + elem.valuestrsize());
+                const mongo::OID *x = (const mongo::OID *) (elem.valuestr() + elem.valuestrsize());
                 if ( format == TenGen )
-                    s << "DBRef(";
+                    out.append("DBRef(");
                 else
-                    s << "{ \"$ref\" : ";
-                s << '"' << elem.valuestr() << "\", ";
+                    out.append("{ \"$ref\" : ");
+                out.push_back('"');
+                out.append(elem.valuestr());
+                out.append("\", ");
                 if ( format != TenGen )
-                    s << "\"$id\" : ";
-                s << '"' << *x << "\"";
-                if ( format == TenGen )
-                    s << ')';
-                else
-                    s << '}';
+                    out.append("\"$id\" : ");
+                out.push_back('"');
+                appendHex(out, x->getData(), mongo::OID::kOIDSize);
+                out.push_back('"');
+                out.push_back( format == TenGen ? ')' : '}' );
                 break;
             }
             case jstOID:
-                if ( format == TenGen ) {
-                    s << "ObjectId(";
-                }
-                else {
-                    s << "{ \"$oid\" : ";
-                }
-                s << '"' << elem.__oid() << '"';
-                if ( format == TenGen ) {
-                    s << ")";
-                }
-                else {
-                    s << " }";
-                }
+                out.append( format == TenGen ? "ObjectId(\"" : "{ \"$oid\" : \"" );
+                appendHex(out, elem.__oid().getData(), mongo::OID::kOIDSize);
+                out.append( format == TenGen ? "\")" : "\" }" );
                 break;
             case BinData: {
                 int len = *(int *)( elem.value() );
                 BinDataType type = BinDataType( *(char *)( (int *)( elem.value() ) + 1 ) );
 
                 if (type == mongo::bdtUUID || type == mongo::newUUID) {
-                    s << HexUtils::formatUuid(elem, uuidEncoding);
+                    out.append(HexUtils::formatUuid(elem, uuidEncoding));
                     break;
                 }
 
-                s << "{ \"$binary\" : \"";
+                out.append("{ \"$binary\" : \"");
                 char *start = ( char * )( elem.value() ) + sizeof( int ) + 1;
-                base64::encode( s , start , len );
-                s << "\", \"$type\" : \"" << hex;
-                s.width( 2 );
-                s.fill( '0' );
-                s << type << dec;
-                s << "\" }";
+                out.append(base64::encode( start , len ));
+                out.append("\", \"$type\" : \"");
+                appendTypeHex(out, static_cast<unsigned int>(static_cast<int>(type)));
+                out.append("\" }");
                 break;
             }
             case mongo::Date:
@@ -244,46 +472,43 @@ namespace Robomongo
                     bool isSupportedDate = miutil::minDate < ms && ms < miutil::maxDate;
 
                     if ( format == Strict )
-                        s << "{ \"$date\" : ";
-                    else{
-                        if(isSupportedDate){
-                            s << "ISODate(";
-                        }
-                        else{
-                            s << "Date(";
-                        }
-                    }
+                        out.append("{ \"$date\" : ");
+                    else
+                        out.append(isSupportedDate ? "ISODate(" : "Date(");
 
                     if ( pretty && isSupportedDate) {
                         boost::posix_time::ptime epoch(boost::gregorian::date(1970,1,1));
                         boost::posix_time::time_duration diff = boost::posix_time::millisec(ms);
                         boost::posix_time::ptime time = epoch + diff;
-                        std::string timestr = miutil::isotimeString(time, true, timeFormat == LocalTime);
-                        s << '"' << timestr << '"';
+                        out.push_back('"');
+                        out.append(miutil::isotimeString(time, true, timeFormat == LocalTime));
+                        out.push_back('"');
                     }
                     else
-                        s << ms;
+                        appendInteger(out, ms);
 
-                    if ( format == Strict )
-                        s << " }";
-                    else
-                        s << ")";
+                    out.append( format == Strict ? " }" : ")" );
                     break;
                 }
             case RegEx:
                 if ( format == Strict ) {
-                    s << "{ \"$regex\" : \"" << escape( elem.regex() );
-                    s << "\", \"$options\" : \"" << elem.regexFlags() << "\" }";
+                    out.append("{ \"$regex\" : \"");
+                    appendEscaped(out, elem.regex(), strlen(elem.regex()), false);
+                    out.append("\", \"$options\" : \"");
+                    out.append(elem.regexFlags());
+                    out.append("\" }");
                 }
                 else {
-                    s << "/" << escape( elem.regex() , true ) << "/";
+                    out.push_back('/');
+                    appendEscaped(out, elem.regex(), strlen(elem.regex()), true);
+                    out.push_back('/');
                     // FIXME Worry about alpha order?
                     for ( const char *f = elem.regexFlags(); *f; ++f ) {
                         switch ( *f ) {
                         case 'g':
                         case 'i':
                         case 'm':
-                            s << *f;
+                            out.push_back(*f);
                         default:
                             break;
                         }
@@ -294,41 +519,65 @@ namespace Robomongo
             case CodeWScope: {
                 BSONObj scope = elem.codeWScopeObject();
                 if ( ! scope.isEmpty() ) {
-                    s << "{ \"$code\" : " << elem._asCode() << " , "
-                      << " \"$scope\" : " << scope.jsonString() << " }";
+                    out.append("{ \"$code\" : ");
+                    out.append(elem._asCode());
+                    out.append(" ,  \"$scope\" : ");
+                    out.append(scope.jsonString());
+                    out.append(" }");
                     break;
                 }
             }
 
             case Code:
-                s << elem._asCode();
+                out.append(elem._asCode());
                 break;
 
             case Timestamp:
                 if ( format == TenGen ) {
-                    s << "Timestamp(" << ( elem.timestampTime() / 1000 ) << ", " << elem.timestampInc() << ")";
+                    out.append("Timestamp(");
+                    appendUnsigned(out, elem.timestampTime() / 1000);
+                    out.append(", ");
+                    appendUnsigned(out, elem.timestampInc());
+                    out.push_back(')');
                 }
                 else {
-                    s << "{ \"$timestamp\" : { \"t\" : " << ( elem.timestampTime() / 1000 ) << ", \"i\" : " << elem.timestampInc() << " } }";
+                    out.append("{ \"$timestamp\" : { \"t\" : ");
+                    appendUnsigned(out, elem.timestampTime() / 1000);
+                    out.append(", \"i\" : ");
+                    appendUnsigned(out, elem.timestampInc());
+                    out.append(" } }");
                 }
                 break;
 
             case MinKey:
-                s << "{ \"$minKey\" : 1 }";
+                out.append("{ \"$minKey\" : 1 }");
                 break;
 
             case MaxKey:
-                s << "{ \"$maxKey\" : 1 }";
+                out.append("{ \"$maxKey\" : 1 }");
                 break;
 
             default:
-                StringBuilder ss;
-                ss << "Cannot create a properly formatted JSON string with "
-                   << "element: " << elem.toString() << " of type: " << elem.type();
+                break;
             }
-            return s.str();
         }
-    
+
+        std::string jsonString(const BSONObj &obj, JsonStringFormat format, int pretty, UUIDEncoding uuidEncoding, SupportedTimes timeFormat, bool isArray)
+        {
+            std::string out;
+            out.reserve(obj.objsize() * 2);
+            appendJsonString(out, obj, format, pretty, uuidEncoding, timeFormat, isArray);
+            return out;
+        }
+
+        std::string jsonString(const BSONElement &elem, JsonStringFormat format, bool includeFieldNames, int pretty, UUIDEncoding uuidEncoding, SupportedTimes timeFormat, bool isArray)
+        {
+            std::string out;
+            out.reserve(elem.size() * 2);
+            appendJsonString(out, elem, format, includeFieldNames, pretty, uuidEncoding, timeFormat, isArray);
+            return out;
+        }
+
         bool isArray(const mongo::BSONElement &elem)
         {
             return isArray(elem.type());
@@ -702,5 +951,32 @@ namespace Robomongo
             }
             return i;
         }
+
+        bool buildUpdate(const mongo::BSONObj &original, const mongo::BSONObj &edited,
+                         mongo::BSONObj &update, mongo::BSONObj &matchOriginal)
+        {
+            mongo::BSONElement id = original.getField("_id");
+            mongo::BSONElement editedId = edited.getField("_id");
+            if (id.eoo() || editedId.eoo() || !isBinaryEqualValue(id, editedId))
+                return false;
+
+            if (!isUpdatableLevel(original, edited))
+                return false;
+
+            mongo::BSONObjBuilder set, unset, match;
+            appendUpdate(original, edited, "", set, unset, match);
+
+            mongo::BSONObjBuilder builder;
+            mongo::BSONObj setObj = set.obj();
+            mongo::BSONObj unsetObj = unset.obj();
+            if (!setObj.isEmpty())
+                builder.append("$set", setObj);
+            if (!unsetObj.isEmpty())
+                builder.append("$unset", unsetObj);
+
+            update = builder.obj();
+            matchOriginal = match.obj();
+            return true;
+        }
     }
 }
@@ -82,6 +82,16 @@ namespace Robomongo
             return bsonelement_cast<typename detail::bson_convert_traits<BSONType_t>::type>(elem);
         }
 
+        /**
+         * @brief Appends JSON of document to 'out' (the same text, that is returned by jsonString).
+         * Whole document is written into single buffer, without intermediate strings.
+         */
+        void appendJsonString(std::string &out, const mongo::BSONObj &obj, mongo::JsonStringFormat format, int pretty,
+            UUIDEncoding uuidEncoding, SupportedTimes timeFormat, bool isArray = false);
+
+        void appendJsonString(std::string &out, const mongo::BSONElement &elem, mongo::JsonStringFormat format, bool includeFieldNames, int pretty,
+            UUIDEncoding uuidEncoding, SupportedTimes timeFormat, bool isArray = false);
+
         std::string jsonString(const mongo::BSONObj &obj, mongo::JsonStringFormat format, int pretty,
             UUIDEncoding uuidEncoding, SupportedTimes timeFormat, bool isArray = false);
 
@@ -105,6 +115,18 @@ namespace Robomongo
 
         mongo::BSONElement indexOf(const mongo::BSONObj &doc, int index);
         int elementsCount(const mongo::BSONObj &doc);
+
+        /**
+         * @brief Builds update of document 'original' into 'edited': $set of new and changed
+         * fields and $unset of removed ones. Changed subdocuments are compared field by field,
+         * changed arrays are set as whole. 'update' is empty, if documents are equal.
+         * 'matchOriginal' receives conditions, that match original values of updated fields
+         * (for arrays and regular expressions condition is weaker than equality).
+         * @return false, if edit can't be expressed with such update (_id or order of
+         * top level fields was changed), then whole document should be saved.
+         */
+        bool buildUpdate(const mongo::BSONObj &original, const mongo::BSONObj &edited,
+                         mongo::BSONObj &update, mongo::BSONObj &matchOriginal);
     }
 }
 
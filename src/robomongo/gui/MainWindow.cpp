@@ -94,12 +94,14 @@ namespace Robomongo
         : BaseClass(),
         _app(AppRegistry::instance().app()),
         _workArea(NULL),
-        _connectionsMenu(NULL)
+        _connectionsMenu(NULL),
+        _cancelOperationButton(NULL)
     {
         AppRegistry::instance().bus()->subscribe(this, ConnectionFailedEvent::Type);
         AppRegistry::instance().bus()->subscribe(this, ScriptExecutedEvent::Type);
         AppRegistry::instance().bus()->subscribe(this, ScriptExecutingEvent::Type);
         AppRegistry::instance().bus()->subscribe(this, QueryWidgetUpdatedEvent::Type);
+        AppRegistry::instance().bus()->subscribe(this, OperationProgressEvent::Type);
 
         QColor background = palette().window().color();
         QString controlKey = "Ctrl";
@@ -376,6 +378,18 @@ namespace Robomongo
         disabelConnectionShortcuts->setChecked(AppRegistry::instance().settingsManager()->disableConnectionShortcuts());
         VERIFY(connect(disabelConnectionShortcuts, SIGNAL(triggered()), this, SLOT(setDisableConnectionShortcuts())));
         optionsMenu->addAction(disabelConnectionShortcuts);
+
+        QAction *lazyCollectionStats = new QAction("Load Collection Statistics On Demand", this);
+        lazyCollectionStats->setCheckable(true);
+        lazyCollectionStats->setChecked(AppRegistry::instance().settingsManager()->lazyCollectionStats());
+        VERIFY(connect(lazyCollectionStats, SIGNAL(triggered()), this, SLOT(setLazyCollectionStats())));
+        optionsMenu->addAction(lazyCollectionStats);
+
+        QAction *checkEditConflicts = new QAction("Don't Save Edits Of Documents Changed On Server", this);
+        checkEditConflicts->setCheckable(true);
+        checkEditConflicts->setChecked(AppRegistry::instance().settingsManager()->checkEditConflicts());
+        VERIFY(connect(checkEditConflicts, SIGNAL(triggered()), this, SLOT(setCheckEditConflicts())));
+        optionsMenu->addAction(checkEditConflicts);
         
         QAction *autoExec = new QAction(tr("Automatically execute code in new tab"),this);
         autoExec->setCheckable(true);
@@ -550,6 +564,14 @@ namespace Robomongo
             .arg(buttonPressedColor.name()));
 
         statusBar()->insertWidget(0, log);
+
+        _cancelOperationButton = new QToolButton(this);
+        _cancelOperationButton->setText("Cancel");
+        _cancelOperationButton->setToolTip("Cancel running operation");
+        _cancelOperationButton->setAutoRaise(true);
+        _cancelOperationButton->hide();
+        VERIFY(connect(_cancelOperationButton, SIGNAL(clicked()), this, SLOT(cancelOperation())));
+        statusBar()->addPermanentWidget(_cancelOperationButton);
         statusBar()->setStyleSheet("QStatusBar::item { border: 0px solid black };");
     }
 
@@ -858,6 +880,20 @@ namespace Robomongo
         AppRegistry::instance().settingsManager()->save();
     }
 
+    void MainWindow::setLazyCollectionStats()
+    {
+        QAction *send = qobject_cast<QAction*>(sender());
+        AppRegistry::instance().settingsManager()->setLazyCollectionStats(send->isChecked());
+        AppRegistry::instance().settingsManager()->save();
+    }
+
+    void MainWindow::setCheckEditConflicts()
+    {
+        QAction *send = qobject_cast<QAction*>(sender());
+        AppRegistry::instance().settingsManager()->setCheckEditConflicts(send->isChecked());
+        AppRegistry::instance().settingsManager()->save();
+    }
+
     void MainWindow::toggleLogs(bool show)
     {
         _logDock->setVisible(show);
@@ -900,6 +936,40 @@ namespace Robomongo
         _orientationAction->setEnabled(event->numOfResults() > 1);
     }
 
+    void MainWindow::handle(OperationProgressEvent *event)
+    {
+        QString description = QtUtils::toQString(event->description());
+        if (event->isFinished()) {
+            if (event->token() != _operation)
+                return;
+
+            _operation.reset();
+            _cancelOperationButton->hide();
+            QString result = event->token() && event->token()->isCancelled() ? "cancelled" : "finished";
+            statusBar()->showMessage(QString("%1: %2 (%3 documents)").arg(description).arg(result).arg(event->done()), 5000);
+            return;
+        }
+
+        _operation = event->token();
+        _cancelOperationButton->setVisible(_operation.get() != NULL);
+
+        QString message = QString("%1: %2").arg(description).arg(event->done());
+        if (event->total() > 0)
+            message += QString(" of %1").arg(event->total());
+        message += QString(" documents, %1 docs/sec").arg(qRound(event->perSecond()));
+        if (event->etaMs() > 0)
+            message += QString(", %1 sec left").arg((event->etaMs() + 999) / 1000);
+        statusBar()->showMessage(message);
+    }
+
+    void MainWindow::cancelOperation()
+    {
+        if (_operation)
+            _operation->cancel();
+
+        _cancelOperationButton->hide();
+    }
+
     void MainWindow::createDatabaseExplorer()
     {
         ExplorerWidget *explorer = new ExplorerWidget(this);
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <QMainWindow>
+
+#include "robomongo/core/mongodb/OperationToken.h"
+
 QT_BEGIN_NAMESPACE
 class QLabel;
 class QToolBar;
@@ -14,6 +17,7 @@ namespace Robomongo
     class ScriptExecutingEvent;
     class ScriptExecutedEvent;
     class QueryWidgetUpdatedEvent;
+    class OperationProgressEvent;
     class WorkAreaTabWidget;
     class ConnectionMenu;
     class App;
@@ -58,6 +62,8 @@ namespace Robomongo
         void setShellAutocompletionNoCollectionNames();
         void setShellAutocompletionNone();
         void setLoadMongoRcJs();
+        void setLazyCollectionStats();
+        void setCheckEditConflicts();
         void setDisableConnectionShortcuts();
 
         void toggleLogs(bool show);
@@ -66,6 +72,7 @@ namespace Robomongo
         void handle(ScriptExecutingEvent *event);
         void handle(ScriptExecutedEvent *event);
         void handle(QueryWidgetUpdatedEvent *event);
+        void handle(OperationProgressEvent *event);
     private Q_SLOTS:
         void updateMenus();
         void setUtcTimeZone();
@@ -77,6 +84,7 @@ namespace Robomongo
         void onExecToolbarVisibilityChanged(bool isVisisble);
         void onExplorerVisibilityChanged(bool isVisisble);
         void onLogsVisibilityChanged(bool isVisible);
+        void cancelOperation();
         
     private:
         QDockWidget *_logDock;
@@ -97,6 +105,12 @@ namespace Robomongo
         QAction *_stopAction;
         QAction *_orientationAction;
         QToolBar *_execToolBar;
+        QToolButton *_cancelOperationButton;
+
+        /**
+         * @brief Operation, which progress is shown in status bar.
+         */
+        OperationTokenPtr _operation;
 
         void updateConnectionsMenu();
         void createDatabaseExplorer();
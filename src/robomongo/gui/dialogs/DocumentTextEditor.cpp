@@ -99,19 +99,10 @@ namespace Robomongo
     bool DocumentTextEditor::validate(bool silentOnSuccess /* = true */)
     {
         QString text = jsonText();
-        int len = 0;
-        try {  
+        try {
             std::string textString = QtUtils::toStdString(text);
-            const char *json = textString.c_str();
-            int jsonLen = textString.length();
-            int offset = 0;
             _obj.clear();
-            while(offset!=jsonLen)
-            { 
-                mongo::BSONObj doc = mongo::Robomongo::fromjson(json+offset,&len);
-                _obj.push_back(doc);
-                offset+=len;
-            }
+            mongo::Robomongo::fromjson(textString.c_str(), textString.length(), _obj);
         } catch (const mongo::ParseMsgAssertionException &ex) {
             QString message = QtUtils::toQString(ex.reason());
             int offset = ex.offset();
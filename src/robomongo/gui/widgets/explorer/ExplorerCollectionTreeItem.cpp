@@ -327,8 +327,17 @@ namespace Robomongo
         _databaseItem->dropIndexFromCollection(this, QtUtils::toStdString(ind->text(0)));
     }
 
+    void ExplorerCollectionTreeItem::updateInfo()
+    {
+        setToolTip(0, buildToolTip(_collection));
+    }
+
     QString ExplorerCollectionTreeItem::buildToolTip(MongoCollection *collection)
     {
+        // Statistics are not loaded yet
+        if (!collection->info().hasStats())
+            return QtUtils::toQString(collection->name());
+
         char buff[2048]={0};
         sprintf(buff,tooltipTemplate,collection->name().c_str(),collection->info().count(),collection->sizeString().c_str());
         return buff;
@@ -31,6 +31,11 @@ namespace Robomongo
         void openCurrentCollectionShell(const QString &script, bool execute = true, const CursorPosition &cursor = CursorPosition());
         ExplorerDatabaseTreeItem *const databaseItem() const { return _databaseItem; }
 
+        /**
+         * @brief Updates tooltip, when statistics of collection are loaded.
+         */
+        void updateInfo();
+
     public Q_SLOTS:
         void handle(LoadCollectionIndexesResponse *event);
         void handle(DeleteCollectionIndexResponse *event);
@@ -3,6 +3,7 @@
 #include <QMessageBox>
 #include <QAction>
 #include <QMenu>
+#include <algorithm>
 
 #include "robomongo/core/domain/MongoDatabase.h"
 #include "robomongo/core/domain/MongoCollection.h"
@@ -73,6 +74,7 @@ namespace Robomongo
         BaseClass::_contextMenu->addAction(dbDrop);
 
         _bus->subscribe(this, MongoDatabaseCollectionListLoadedEvent::Type, _database);
+        _bus->subscribe(this, MongoDatabaseCollectionsStatsLoadedEvent::Type, _database);
         _bus->subscribe(this, MongoDatabaseUsersLoadedEvent::Type, _database);
         _bus->subscribe(this, MongoDatabaseFunctionsLoadedEvent::Type, _database);
         _bus->subscribe(this, MongoDatabaseCollectionsLoadingEvent::Type, _database);
@@ -160,6 +162,27 @@ namespace Robomongo
         showCollectionSystemFolderIfNeeded();
     }
 
+    void ExplorerDatabaseTreeItem::handle(MongoDatabaseCollectionsStatsLoadedEvent *event)
+    {
+        updateCollectionItems(_collectionFolderItem, event->collections);
+        updateCollectionItems(_collectionSystemFolderItem, event->collections);
+    }
+
+    void ExplorerDatabaseTreeItem::updateCollectionItems(QTreeWidgetItem *folder, const std::vector<MongoCollection *> &collections)
+    {
+        if (!folder)
+            return;
+
+        for (int i = 0; i < folder->childCount(); ++i) {
+            ExplorerCollectionTreeItem *item = dynamic_cast<ExplorerCollectionTreeItem *>(folder->child(i));
+            if (!item)
+                continue;
+
+            if (std::find(collections.begin(), collections.end(), item->collection()) != collections.end())
+                item->updateInfo();
+        }
+    }
+
     void ExplorerDatabaseTreeItem::handle(MongoDatabaseUsersLoadedEvent *event)
     {
         std::vector<MongoUser> users = event->users();
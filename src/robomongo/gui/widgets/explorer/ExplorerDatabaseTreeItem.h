@@ -13,6 +13,7 @@ namespace Robomongo
     class ExplorerDatabaseCategoryTreeItem;
     class EventBus;
     class MongoDatabaseCollectionListLoadedEvent;
+    class MongoDatabaseCollectionsStatsLoadedEvent;
     class MongoDatabaseUsersLoadedEvent;
     class MongoDatabaseFunctionsLoadedEvent;
     class MongoDatabaseCollectionsLoadingEvent;
@@ -43,6 +44,7 @@ namespace Robomongo
 
     public Q_SLOTS:
         void handle(MongoDatabaseCollectionListLoadedEvent *event);
+        void handle(MongoDatabaseCollectionsStatsLoadedEvent *event);
         void handle(MongoDatabaseUsersLoadedEvent *event);
         void handle(MongoDatabaseFunctionsLoadedEvent *event);
         void handle(MongoDatabaseCollectionsLoadingEvent *event);
@@ -60,6 +62,7 @@ namespace Robomongo
         void addCollectionItem(MongoCollection *collection);
         void addSystemCollectionItem(MongoCollection *collection);
         void showCollectionSystemFolderIfNeeded();
+        void updateCollectionItems(QTreeWidgetItem *folder, const std::vector<MongoCollection *> &collections);
 
         void addUserItem(MongoDatabase *database, const MongoUser &user);
         void addFunctionItem(MongoDatabase *database, const MongoFunction &function);
@@ -1,6 +1,16 @@
 #include "robomongo/gui/widgets/explorer/ExplorerTreeWidget.h"
 #include "robomongo/gui/widgets/explorer/ExplorerTreeItem.h"
+#include "robomongo/gui/widgets/explorer/ExplorerCollectionTreeItem.h"
 #include <QContextMenuEvent>
+#include <QHelpEvent>
+#include <QScrollBar>
+#include <QTimer>
+#include <map>
+
+#include "robomongo/core/domain/MongoCollection.h"
+#include "robomongo/core/settings/SettingsManager.h"
+#include "robomongo/core/utils/QtUtils.h"
+#include "robomongo/core/AppRegistry.h"
 
 namespace Robomongo
 {
@@ -14,6 +24,16 @@ namespace Robomongo
         setIndentation(15);
         setHeaderHidden(true);
         setSelectionMode(QAbstractItemView::SingleSelection);
+
+        _visibleStatsTimer = new QTimer(this);
+        _visibleStatsTimer->setSingleShot(true);
+        _visibleStatsTimer->setInterval(visibleStatsDelayMs);
+        VERIFY(connect(_visibleStatsTimer, SIGNAL(timeout()), this, SLOT(loadVisibleStats())));
+        VERIFY(connect(verticalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(scheduleVisibleStats())));
+        VERIFY(connect(this, SIGNAL(itemExpanded(QTreeWidgetItem *)), this, SLOT(scheduleVisibleStats())));
+
+        // Collections are added to already expanded database
+        VERIFY(connect(model(), SIGNAL(rowsInserted(const QModelIndex &, int, int)), this, SLOT(scheduleVisibleStats())));
     }
 
     void ExplorerTreeWidget::contextMenuEvent(QContextMenuEvent *event)
@@ -26,4 +46,63 @@ namespace Robomongo
             }
         }
     }
+
+    bool ExplorerTreeWidget::viewportEvent(QEvent *event)
+    {
+        if (event->type() == QEvent::ToolTip) {
+            QHelpEvent *helpEvent = static_cast<QHelpEvent *>(event);
+            ExplorerCollectionTreeItem *item = dynamic_cast<ExplorerCollectionTreeItem *>(itemAt(helpEvent->pos()));
+            if (item) {
+                loadStats(std::vector<ExplorerCollectionTreeItem *>(1, item));
+            }
+        }
+
+        return QTreeWidget::viewportEvent(event);
+    }
+
+    void ExplorerTreeWidget::resizeEvent(QResizeEvent *event)
+    {
+        QTreeWidget::resizeEvent(event);
+        scheduleVisibleStats();
+    }
+
+    void ExplorerTreeWidget::scheduleVisibleStats()
+    {
+        if (!AppRegistry::instance().settingsManager()->lazyCollectionStats())
+            return;
+
+        _visibleStatsTimer->start();
+    }
+
+    void ExplorerTreeWidget::loadVisibleStats()
+    {
+        std::vector<ExplorerCollectionTreeItem *> items;
+        int bottom = viewport()->height();
+        for (QTreeWidgetItem *item = itemAt(0, 0); item && visualItemRect(item).top() < bottom; item = itemBelow(item)) {
+            ExplorerCollectionTreeItem *collectionItem = dynamic_cast<ExplorerCollectionTreeItem *>(item);
+            if (collectionItem) {
+                items.push_back(collectionItem);
+            }
+        }
+
+        loadStats(items);
+    }
+
+    void ExplorerTreeWidget::loadStats(const std::vector<ExplorerCollectionTreeItem *> &items)
+    {
+        if (!AppRegistry::instance().settingsManager()->lazyCollectionStats())
+            return;
+
+        // Visible collections may belong to different databases
+        typedef std::map<MongoDatabase *, std::vector<MongoCollection *> > CollectionsByDatabaseType;
+        CollectionsByDatabaseType collections;
+        for (std::vector<ExplorerCollectionTreeItem *>::const_iterator it = items.begin(); it != items.end(); ++it) {
+            MongoCollection *collection = (*it)->collection();
+            collections[collection->database()].push_back(collection);
+        }
+
+        for (CollectionsByDatabaseType::const_iterator it = collections.begin(); it != collections.end(); ++it) {
+            it->first->loadCollectionStats(it->second);
+        }
+    }
 }
@@ -2,14 +2,40 @@
 
 #include <QTreeWidget>
 
+QT_BEGIN_NAMESPACE
+class QTimer;
+QT_END_NAMESPACE
+
 namespace Robomongo
 {
+    class ExplorerCollectionTreeItem;
+
     class ExplorerTreeWidget : public QTreeWidget
     {
         Q_OBJECT
     public:
         explicit ExplorerTreeWidget(QWidget *parent = 0);
+
+        /**
+         * @brief Delay after scrolling, before statistics of visible collections are requested.
+         */
+        enum{visibleStatsDelayMs = 200};
+
     protected:
         virtual void contextMenuEvent(QContextMenuEvent *event);
+        virtual bool viewportEvent(QEvent *event);
+        virtual void resizeEvent(QResizeEvent *event);
+
+    private Q_SLOTS:
+        void scheduleVisibleStats();
+        void loadVisibleStats();
+
+    private:
+        /**
+         * @brief In lazy mode statistics are loaded only for collections,
+         * visible in viewport or hovered for tooltip.
+         */
+        void loadStats(const std::vector<ExplorerCollectionTreeItem *> &items);
+        QTimer *_visibleStatsTimer;
     };
 }
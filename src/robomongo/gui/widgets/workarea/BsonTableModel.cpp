@@ -3,7 +3,8 @@
 #include <QBrush>
 #include <QIcon>
 
-#include "robomongo/gui/widgets/workarea/BsonTreeItem.h"
+#include <mongo/bson/bsonobjiterator.h>
+
 #include "robomongo/gui/widgets/workarea/BsonTreeModel.h"
 #include "robomongo/core/utils/QtUtils.h"
 
@@ -17,14 +18,17 @@ namespace Robomongo
 
     int BsonTableModelProxy::rowCount(const QModelIndex &parent) const
     {
-        int count = sourceModel()->rowCount(parent);
+        if (parent.isValid())
+            return 0;
+
+        int count = sourceModel()->rowCount();
         return count;
     }
 
     QModelIndex BsonTableModelProxy::parent( const QModelIndex& index ) const
     {
-        QModelIndex sourceParent = sourceModel()->parent( mapToSource(index) );
-        return sourceParent;
+        // Table is flat: only documents (top level rows of source) are shown
+        return QModelIndex();
     }
 
     int BsonTableModelProxy::columnCount(const QModelIndex &parent) const
@@ -32,18 +36,28 @@ namespace Robomongo
         return _columns.size();
     }
 
+    /**
+     * @brief Row of proxy index is row of document in source model (nodes of
+     * fields are created by source model on demand and can be discarded).
+     */
     QModelIndex BsonTableModelProxy::mapFromSource( const QModelIndex & sourceIndex ) const
     {
-        int row = sourceIndex.row();
-        int col = sourceIndex.column();
-
-        BsonTreeItem *node = QtUtils::item<BsonTreeItem *>(sourceIndex);
-        if (!node || _columns.size() <= col)
+        if (!sourceIndex.isValid())
             return QModelIndex();
 
-        BsonTreeItem *child = node->childByKey(_columns[col]);
+        if (!sourceIndex.parent().isValid())
+            return createIndex(sourceIndex.row(), 0);
+
+        // Field of embedded document is mapped to the cell of its top level field
+        QModelIndex field = sourceIndex;
+        while (field.parent().parent().isValid())
+            field = field.parent();
 
-        return createIndex( row, col, child );
+        ColumnIdsType::const_iterator col = _columnIds.find(BsonTreeModel::item(field).element().fieldName());
+        if (col == _columnIds.end())
+            return QModelIndex();
+
+        return createIndex(field.parent().row(), col->second);
     }
 
     QModelIndex BsonTableModelProxy::sibling(int row, int column, const QModelIndex &idx) const
@@ -53,13 +67,10 @@ namespace Robomongo
 
     QModelIndex BsonTableModelProxy::index( int row, int col, const QModelIndex& parent ) const
     {
-        BsonTreeItem *node = QtUtils::item<BsonTreeItem *>(sourceModel()->index(row,0,parent));
-        if (!node || _columns.size() <= col)
+        if (parent.isValid() || row < 0 || row >= rowCount() || col < 0 || _columns.size() <= col)
             return QModelIndex();
 
-        BsonTreeItem *child = node->childByKey(_columns[col]);
-
-        return createIndex( row, col, child );
+        return createIndex( row, col );
     }
 
     QModelIndex BsonTableModelProxy::mapToSource( const QModelIndex &proxyIndex ) const
@@ -69,40 +80,139 @@ namespace Robomongo
 
         Q_ASSERT( proxyIndex.model() == this );
 
-        QModelIndex sourceIndex;
-        BsonTreeItem *child = static_cast<BsonTreeItem *>(proxyIndex.internalPointer());
-        if (child) {
-            QtUtils::HackQModelIndex* hack = reinterpret_cast<QtUtils::HackQModelIndex*>(&sourceIndex);
-            BsonTreeItem *parent = static_cast<BsonTreeItem *>(child->parent());
-            hack->r = proxyIndex.row();
-            hack->c = proxyIndex.column();
-            hack->i = parent;
-            hack->m = sourceModel();
+        QModelIndex sourceDocument = sourceModel()->index(proxyIndex.row(), 0);
+        mongo::BSONObj document = BsonTreeModel::item(sourceDocument).superRoot();
+        int offset = fieldOffset(proxyIndex.row(), proxyIndex.column(), document);
+        if (!offset)
+            return QModelIndex();
+
+        // Position of the field is needed only here (selection), so it is not indexed
+        int fieldRow = 0;
+        mongo::BSONObjIterator iterator(document);
+        while (iterator.next().rawdata() != document.objdata() + offset)
+            ++fieldRow;
+
+        return sourceModel()->index(fieldRow, 0, sourceDocument);
+    }
+
+    Qt::ItemFlags BsonTableModelProxy::flags(const QModelIndex &index) const
+    {
+        Qt::ItemFlags result = 0;
+        if (index.isValid()) {
+            result = Qt::ItemIsSelectable | Qt::ItemIsEnabled;
         }
-        return sourceIndex;
+        return result;
     }
 
     void BsonTableModelProxy::setSourceModel( QAbstractItemModel* model )
     {
         if (model) {
-            BsonTreeItem *child = QtUtils::item<BsonTreeItem *>(model->index(0,0));
-            if (child) {
-                _root = qobject_cast<BsonTreeItem *>(child->parent());
-                if (_root) {
-                    int count = _root->childrenCount();
-                    for (int i=0; i < count; ++i) {
-                        BsonTreeItem *child = _root->child(i);
-                        int countc = child->childrenCount();
-                        for (int j = 0; j < countc; ++j) {
-                            addColumn(child->child(j)->key());
-                        }
-                    }
+            int count = model->rowCount();
+            for (int i = 0; i < count; ++i) {
+                mongo::BSONObjIterator iterator(BsonTreeModel::item(model->index(i, 0)).superRoot());
+                while (iterator.more()) {
+                    addColumn(iterator.next().fieldName());
                 }
             }
+            _rows.resize(count);
+
+            VERIFY(connect(model, SIGNAL(rowsAboutToBeInserted(const QModelIndex&, int, int)),
+                this, SLOT(sourceRowsAboutToBeInserted(const QModelIndex&, int, int))));
+            VERIFY(connect(model, SIGNAL(rowsInserted(const QModelIndex&, int, int)),
+                this, SLOT(sourceRowsInserted(const QModelIndex&, int, int))));
+            VERIFY(connect(model, SIGNAL(rowsAboutToBeRemoved(const QModelIndex&, int, int)),
+                this, SLOT(sourceRowsAboutToBeRemoved(const QModelIndex&, int, int))));
+            VERIFY(connect(model, SIGNAL(rowsRemoved(const QModelIndex&, int, int)),
+                this, SLOT(sourceRowsRemoved(const QModelIndex&, int, int))));
+            VERIFY(connect(model, SIGNAL(dataChanged(const QModelIndex&, const QModelIndex&)),
+                this, SLOT(sourceDataChanged(const QModelIndex&, const QModelIndex&))));
         }
         return BaseClass::setSourceModel(model);
     }
 
+    void BsonTableModelProxy::sourceRowsAboutToBeInserted(const QModelIndex &parent, int first, int last)
+    {
+        // Only documents (top level rows) are shown in the table
+        if (parent.isValid())
+            return;
+
+        beginInsertRows(QModelIndex(), first, last);
+    }
+
+    void BsonTableModelProxy::sourceRowsInserted(const QModelIndex &parent, int first, int last)
+    {
+        if (parent.isValid())
+            return;
+
+        _rows.resize(sourceModel()->rowCount());
+        endInsertRows();
+        addColumns(first, last);
+    }
+
+    void BsonTableModelProxy::sourceRowsAboutToBeRemoved(const QModelIndex &parent, int first, int last)
+    {
+        if (parent.isValid())
+            return;
+
+        beginRemoveRows(QModelIndex(), first, last);
+    }
+
+    void BsonTableModelProxy::sourceRowsRemoved(const QModelIndex &parent, int first, int last)
+    {
+        if (parent.isValid())
+            return;
+
+        _rows.erase(_rows.begin() + first, _rows.begin() + last + 1);
+        endRemoveRows();
+    }
+
+    /**
+     * @brief Document of source row was replaced: its field index is rebuilt
+     * on next request and columns are added for its new fields.
+     */
+    void BsonTableModelProxy::sourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight)
+    {
+        if (topLeft.parent().isValid())
+            return;
+
+        for (int row = topLeft.row(); row <= bottomRight.row(); ++row) {
+            _rows[row].clear();
+        }
+        addColumns(topLeft.row(), bottomRight.row());
+
+        if (!_columns.empty())
+            emit dataChanged(index(topLeft.row(), 0, QModelIndex()), index(bottomRight.row(), _columns.size() - 1, QModelIndex()));
+    }
+
+    /**
+     * @brief Adds columns for fields of source rows [first, last]
+     * that were not seen in previous rows.
+     */
+    void BsonTableModelProxy::addColumns(int first, int last)
+    {
+        std::vector<std::string> newColumns;
+        ColumnIdsType newColumnIds;
+        for (int i = first; i <= last; ++i) {
+            mongo::BSONObjIterator iterator(BsonTreeModel::item(sourceModel()->index(i, 0)).superRoot());
+            while (iterator.more()) {
+                const char *name = iterator.next().fieldName();
+                if (_columnIds.find(name) == _columnIds.end()
+                    && newColumnIds.insert(std::make_pair(name, 0)).second) {
+                    newColumns.push_back(name);
+                }
+            }
+        }
+
+        if (newColumns.empty())
+            return;
+
+        beginInsertColumns(QModelIndex(), _columns.size(), _columns.size() + newColumns.size() - 1);
+        for (std::vector<std::string>::const_iterator it = newColumns.begin(); it != newColumns.end(); ++it) {
+            addColumn(*it);
+        }
+        endInsertColumns();
+    }
+
     QVariant BsonTableModelProxy::data(const QModelIndex &index, int role) const
     {
         QVariant result;
@@ -110,26 +220,30 @@ namespace Robomongo
         if (!index.isValid())
             return result;
 
-        BsonTreeItem *node = QtUtils::item<BsonTreeItem *>(index);
+        mongo::BSONObj document = BsonTreeModel::item(sourceModel()->index(index.row(), 0)).superRoot();
+        int offset = fieldOffset(index.row(), index.column(), document);
 
-        if (!node) {
+        if (!offset) {
             if (role == Qt::BackgroundRole) {
                 return QBrush("#f5f3f2");
             }
             return result;
         }
 
+        mongo::BSONElement element(document.objdata() + offset);
+
         if (role == Qt::DisplayRole || role == Qt::ToolTipRole) {
-            bool isCut = node->type() == mongo::String ||  node->type() == mongo::Code || node->type() == mongo::CodeWScope;  
+            bool isCut = element.type() == mongo::String ||  element.type() == mongo::Code || element.type() == mongo::CodeWScope;  
+            QString value = BsonTreeItem::elementValue(element);
             if (role == Qt::ToolTipRole){
-                result = isCut ? node->value() : node->value().left(500); 
+                result = isCut ? value : value.left(500); 
             }
             else{
-                result = isCut ? node->value() : node->value().simplified().left(300); 
+                result = isCut ? value : value.simplified().left(300); 
             }
         }
         else if (role == Qt::DecorationRole) {
-            return BsonTreeModel::getIcon(node);
+            return BsonTreeModel::getIcon(element.type());
         }
 
         return result;
@@ -152,22 +266,43 @@ namespace Robomongo
         return _columns[col];
     }
 
-    size_t BsonTableModelProxy::findIndexColumn(const QString &col) const
+    /**
+     * @returns offset of the field, that is shown in column 'col', in buffer of
+     * 'document' (source document of 'row'), or 0 if document doesn't have this field.
+     * Offsets of all fields of row are indexed by column on first request.
+     */
+    int BsonTableModelProxy::fieldOffset(int row, int col, const mongo::BSONObj &document) const
     {
-        for (int i = 0; i < _columns.size(); ++i) {
-            if (_columns[i] == col) {
-                return i;
+        RowFieldsType &fields = _rows[row];
+        if (fields.empty()) {
+            bool isComplete = true;
+            RowFieldsType built(_columns.size(), 0);
+            mongo::BSONObjIterator iterator(document);
+            while (iterator.more()) {
+                mongo::BSONElement element = iterator.next();
+                ColumnIdsType::const_iterator it = _columnIds.find(element.fieldName());
+                if (it == _columnIds.end()) {
+                    // Columns of this row are not added yet, index it on next request
+                    isComplete = false;
+                    continue;
+                }
+                built[it->second] = static_cast<int>(element.rawdata() - document.objdata());
             }
+
+            if (!isComplete)
+                return col < built.size() ? built[col] : 0;
+
+            fields.swap(built);
         }
-        return _columns.size();
+
+        // Columns, that were added after indexing of the row, are not in this document
+        return col < fields.size() ? fields[col] : 0;
     }
 
-    size_t BsonTableModelProxy::addColumn(const QString &col)
+    void BsonTableModelProxy::addColumn(const std::string &name)
     {
-        size_t column = findIndexColumn(col);
-        if (column == _columns.size()) {
-            _columns.push_back(col);
+        if (_columnIds.insert(std::make_pair(name, static_cast<int>(_columns.size()))).second) {
+            _columns.push_back(QtUtils::toQString(name));
         }
-        return column;
     }
 }
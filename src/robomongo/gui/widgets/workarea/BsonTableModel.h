@@ -1,11 +1,13 @@
 #pragma once
+#include <map>
+#include <string>
 #include <vector>
 
 #include <QAbstractProxyModel>
+#include <mongo/bson/bsonobj.h>
 
 namespace Robomongo
 {
-    class BsonTreeItem;
 
     class BsonTableModelProxy : public QAbstractProxyModel
     {
@@ -14,6 +16,13 @@ namespace Robomongo
     public:
         typedef QAbstractProxyModel BaseClass;
         typedef std::vector<QString> ColumnsValuesType;
+        typedef std::map<std::string, int> ColumnIdsType;
+
+        /**
+         * @brief Offsets of fields in document's buffer by column id (0, if
+         * document doesn't have field of column).
+         */
+        typedef std::vector<int> RowFieldsType;
 
         explicit BsonTableModelProxy(QObject *parent = 0);
         QVariant data(const QModelIndex &index, int role) const;
@@ -28,12 +37,34 @@ namespace Robomongo
         virtual void setSourceModel( QAbstractItemModel* model );
         virtual QModelIndex parent( const QModelIndex& index ) const;
         virtual QModelIndex sibling(int row, int column, const QModelIndex &idx) const;
+        virtual Qt::ItemFlags flags(const QModelIndex &index) const;
+
+    private Q_SLOTS:
+        void sourceRowsAboutToBeInserted(const QModelIndex &parent, int first, int last);
+        void sourceRowsInserted(const QModelIndex &parent, int first, int last);
+        void sourceRowsAboutToBeRemoved(const QModelIndex &parent, int first, int last);
+        void sourceRowsRemoved(const QModelIndex &parent, int first, int last);
+        void sourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight);
+
     private:
+        void addColumns(int first, int last);
         QString column(int col) const;
-        size_t addColumn(const QString &col);
-        size_t findIndexColumn(const QString &col) const;
+        void addColumn(const std::string &name);
+        int fieldOffset(int row, int col, const mongo::BSONObj &document) const;
 
+        /**
+         * @brief Names of columns (index is column id).
+         */
         ColumnsValuesType _columns;
-        BsonTreeItem *_root;
+
+        /**
+         * @brief Column ids, interned by field name.
+         */
+        ColumnIdsType _columnIds;
+
+        /**
+         * @brief Field index of each row (empty, if row was not requested yet).
+         */
+        mutable std::vector<RowFieldsType> _rows;
     };
 }
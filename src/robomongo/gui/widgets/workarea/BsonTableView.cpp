@@ -4,8 +4,9 @@
 #include <QAction>
 #include <QMenu>
 #include <QKeyEvent>
+#include <QAbstractProxyModel>
 
-#include "robomongo/gui/widgets/workarea/BsonTreeItem.h"
+#include "robomongo/gui/widgets/workarea/BsonTreeModel.h"
 #include "robomongo/gui/GuiRegistry.h"
 #include "robomongo/core/utils/QtUtils.h"
 
@@ -44,7 +45,9 @@ namespace Robomongo
         if (indexes.count() != 1)
             return QModelIndex();
 
-        return indexes[0];
+        // Index of the field in the tree model: proxy indexes point to documents
+        QAbstractProxyModel *proxy = qobject_cast<QAbstractProxyModel *>(model());
+        return proxy ? proxy->mapToSource(indexes[0]) : indexes[0];
     }
 
     QModelIndexList BsonTableView::selectedIndexes() const
@@ -66,7 +69,7 @@ namespace Robomongo
         }
         else{
             QModelIndex selectedInd = selectedIndex();
-            BsonTreeItem *documentItem = QtUtils::item<BsonTreeItem*>(selectedInd);
+            BsonTreeItem documentItem = BsonTreeModel::item(selectedInd);
             QMenu menu(this);
             _notifier.initMenu(&menu,documentItem);
             menu.exec(menuPoint);
@@ -1,157 +1,102 @@
 #include "robomongo/gui/widgets/workarea/BsonTreeItem.h"
 #include <mongo/client/dbclient.h>
 
-using namespace mongo;
-namespace
-{
-    struct removeIfFound : public std::unary_function<const Robomongo::BsonTreeItem*, bool> 
-    {
-        removeIfFound(Robomongo::BsonTreeItem *item) :_whatSearch(item) {}
-        bool operator()(const Robomongo::BsonTreeItem* item) const
-        {
-            if (item == _whatSearch) {
-                delete _whatSearch;
-                return true;
-            }
-            return false;
-        }
-        const Robomongo::BsonTreeItem *const _whatSearch;
-    };
-
-    const Robomongo::BsonTreeItem *findSuperRoot(const Robomongo::BsonTreeItem *const item)
-    {
-        Robomongo::BsonTreeItem *parent = qobject_cast<Robomongo::BsonTreeItem *>(item->parent());
-        if(parent){
-            Robomongo::BsonTreeItem *grParent = qobject_cast<Robomongo::BsonTreeItem *>(parent->parent());
-            if(grParent){
-               return findSuperRoot(parent);
-            }
-        }
-        return item;
-    }
-}
+#include "robomongo/core/settings/SettingsManager.h"
+#include "robomongo/core/AppRegistry.h"
+#include "robomongo/core/utils/BsonUtils.h"
+#include "robomongo/core/utils/QtUtils.h"
+
 namespace Robomongo
 {
-    BsonTreeItem::BsonTreeItem(QObject *parent) 
-        :BaseClass(parent)
-    {
-       
-    }
-
-    BsonTreeItem::BsonTreeItem(const mongo::BSONObj &bsonObjRoot, QObject *parent)
-        :BaseClass(parent),
-        _root(bsonObjRoot)
+    BsonTreeItem::BsonTreeItem()
+        :_documentRow(-1),
+        _offset(0)
     {
 
     }
 
-    unsigned BsonTreeItem::childrenCount() const
+    BsonTreeItem::BsonTreeItem(const mongo::BSONObj &document, int documentRow, int offset)
+        :_document(document),
+        _documentRow(documentRow),
+        _offset(offset)
     {
-        return _items.size();
-    }
 
-    void BsonTreeItem::clear()
-    {
-        _items.clear();
     }
 
-    void BsonTreeItem::addChild(BsonTreeItem *item)
+    bool BsonTreeItem::isNull() const
     {
-        _items.push_back(item);
+        return _documentRow < 0;
     }
 
-    BsonTreeItem* BsonTreeItem::child(unsigned pos) const
+    bool BsonTreeItem::isDocumentItem() const
     {
-        return _items[pos];
+        return !isNull() && _offset == 0;
     }
 
-    BsonTreeItem* BsonTreeItem::childSafe(unsigned pos) const
+    int BsonTreeItem::documentRow() const
     {
-        if (childrenCount() > pos) {
-            return _items[pos];
-        }
-        else {
-            return NULL;
-        }
+        return _documentRow;
     }
 
-    BsonTreeItem* BsonTreeItem::childByKey(const QString &val)
+    mongo::BSONObj BsonTreeItem::superRoot() const
     {
-        for (unsigned i=0; i < _items.size(); ++i) {
-            if (_items[i]->key() == val) {
-                return _items[i];
-            }
-        }
-        return NULL;
+        return _document;
     }
 
-    const BsonTreeItem *BsonTreeItem::superParent() const
+    mongo::BSONObj BsonTreeItem::obj() const
     {
-        return findSuperRoot(this);
-    }
+        if (_offset == 0)
+            return _document;
 
-    mongo::BSONObj BsonTreeItem::superRoot() const
-    {
-        return superParent()->root();
-    }
+        mongo::BSONElement elem = element();
+        if (BsonUtils::isDocument(elem))
+            return elem.embeddedObject();
 
-    mongo::BSONObj BsonTreeItem::root() const
-    {
-        return _root;
+        return mongo::BSONObj();
     }
 
-    int BsonTreeItem::indexOf(BsonTreeItem *item) const
+    mongo::BSONElement BsonTreeItem::element() const
     {
-        for (unsigned i=0; i < _items.size(); ++i) {
-            if (item == _items[i]) {
-                return i;
-            }
-        }
-        return -1;
+        if (_offset == 0)
+            return mongo::BSONElement();
+
+        return mongo::BSONElement(_document.objdata() + _offset);
     }
 
     QString BsonTreeItem::key() const
     {
-        return _fields._key;
+        return QtUtils::toQString(std::string(element().fieldName()));
     }
 
     QString BsonTreeItem::value() const
     {
-        return _fields._value;
-    }
+        if (_offset == 0)
+            return QString("{ %1 fields }").arg(BsonUtils::elementsCount(_document));
 
-    mongo::BSONType BsonTreeItem::type() const
-    {
-        return _fields._type;
+        return elementValue(element());
     }
 
-    void BsonTreeItem::setKey(const QString &key)
+    QString BsonTreeItem::elementValue(const mongo::BSONElement &element)
     {
-        _fields._key = key;
-    }
+        if (BsonUtils::isArray(element))
+            return QString("Array [%1]").arg(BsonUtils::elementsCount(element.embeddedObject()));
 
-    void BsonTreeItem::setValue(const QString &value)
-    {
-        _fields._value = value;
-    }
+        if (BsonUtils::isDocument(element))
+            return QString("{ %1 fields }").arg(BsonUtils::elementsCount(element.embeddedObject()));
 
-    void BsonTreeItem::setType(mongo::BSONType type)
-    {
-       _fields._type = type;
+        std::string result;
+        BsonUtils::buildJsonString(element, result, AppRegistry::instance().settingsManager()->uuidEncoding(), AppRegistry::instance().settingsManager()->timeZone());
+        return QtUtils::toQString(result);
     }
 
-    mongo::BinDataType BsonTreeItem::binType() const
-    {
-        return _fields._binType;
-    }
-
-    void BsonTreeItem::setBinType(mongo::BinDataType type)
+    mongo::BSONType BsonTreeItem::type() const
     {
-        _fields._binType = type;
+        return _offset == 0 ? mongo::Object : element().type();
     }
 
-    void BsonTreeItem::removeChild(BsonTreeItem *item)
+    mongo::BinDataType BsonTreeItem::binType() const
     {
-        _items.erase(std::remove_if(_items.begin(), _items.end(), removeIfFound(item)),_items.end());
+        mongo::BSONElement elem = element();
+        return elem.type() == mongo::BinData ? elem.binDataType() : mongo::BinDataGeneral;
     }
 }
@@ -1,26 +1,58 @@
 #pragma once
 
-#include <vector>
-#include <QObject>
+#include <QString>
 #include <mongo/bson/bsonobj.h>
 #include <mongo/bson/bsonelement.h>
 
 namespace Robomongo
 {
     /**
-     * @brief BSON tree item (represents array or object)
+     * @brief Node of BsonTreeModel. Nodes are plain structs, stored in the arena
+     * of model (one vector per result set) and referenced by position in arena.
+     * Node doesn't copy data of the field, it keeps offset of BSON element in
+     * buffer of top level document.
      */
-    struct BsonItemFields
+    struct BsonTreeNode
     {
-        QString _key;
-        QString _value;
-        mongo::BSONType _type;
-        mongo::BinDataType _binType;
+        /**
+         * @brief Row of top level document in the model.
+         */
+        int document;
+
+        /**
+         * @brief Position of parent node in arena (-1 for top level document).
+         */
+        int parent;
+
+        /**
+         * @brief Row of this node in parent.
+         */
+        int row;
+
+        /**
+         * @brief Offset of element in document's buffer (0 for document itself).
+         */
+        int offset;
+
+        /**
+         * @brief Position of first child in arena (children are stored contiguously)
+         * or -1, if children were not created yet.
+         */
+        int firstChild;
+
+        /**
+         * @brief Number of fields in document or array, -1 if not counted yet.
+         */
+        int childrenCount;
     };
 
-    class BsonTreeItem : public QObject
+    /**
+     * @brief BSON tree item (top level document or one field of document), that
+     * is returned by BsonTreeModel::item(). Item is lightweight handle, that
+     * reads key, value and type from BSON element on demand.
+     */
+    class BsonTreeItem
     {
-        Q_OBJECT
     public:
         enum eColumn
         {
@@ -30,41 +62,55 @@ namespace Robomongo
             eCountColumns = 3
         };
 
-        typedef QObject BaseClass;
-        typedef std::vector<BsonTreeItem*> ChildContainerType;
+        /**
+         * @brief Creates null item.
+         */
+        BsonTreeItem();
 
-        explicit BsonTreeItem(QObject *parent = 0);
-        explicit BsonTreeItem(const mongo::BSONObj &bsonObjRoot, QObject *parent = 0);
+        /**
+         * @brief Creates item of field at 'offset' in buffer of 'document'
+         * (or item of document itself, if offset is 0).
+         */
+        BsonTreeItem(const mongo::BSONObj &document, int documentRow, int offset);
 
-        unsigned childrenCount() const;
-        void clear();
-        void addChild(BsonTreeItem *item);
-        void removeChild(BsonTreeItem *item);
-        BsonTreeItem* child(unsigned pos) const;
-        BsonTreeItem* childSafe(unsigned pos) const;
-        BsonTreeItem* childByKey(const QString &val);
-        int indexOf(BsonTreeItem *item) const;
+        bool isNull() const;
 
-        const BsonTreeItem* superParent() const;
-        mongo::BSONObj root() const;
+        /**
+         * @brief Tests whether this item is top level document.
+         */
+        bool isDocumentItem() const;
+
+        /**
+         * @brief Row of top level document, that contains this item.
+         */
+        int documentRow() const;
+
+        /**
+         * @brief Top level document, that contains this item.
+         */
         mongo::BSONObj superRoot() const;
 
-        QString key() const;
-        void setKey(const QString &key);
+        /**
+         * @brief Document or array, whose fields are children of this item
+         * (empty object for items of simple types).
+         */
+        mongo::BSONObj obj() const;
+        mongo::BSONElement element() const;
 
+        QString key() const;
         QString value() const;
-        void setValue(const QString &value);
 
-        mongo::BSONType type() const;
-        void setType(mongo::BSONType type);
+        /**
+         * @brief Text of the element, that is shown in "Value" column.
+         */
+        static QString elementValue(const mongo::BSONElement &element);
 
+        mongo::BSONType type() const;
         mongo::BinDataType binType() const;
-        void setBinType(mongo::BinDataType type);
-
-    protected:
 
-        const mongo::BSONObj _root;
-        ChildContainerType _items;
-        BsonItemFields _fields;
+    private:
+        mongo::BSONObj _document;
+        int _documentRow;
+        int _offset;
     };
 }
@@ -1,112 +1,250 @@
 #include "robomongo/gui/widgets/workarea/BsonTreeModel.h"
 
+#include <set>
+#include <QAbstractProxyModel>
+
 #include <mongo/client/dbclient.h>
 #include <mongo/bson/bsonobjiterator.h>
 #include "robomongo/core/settings/SettingsManager.h"
 #include "robomongo/core/AppRegistry.h"
 #include "robomongo/core/utils/BsonUtils.h"
 #include "robomongo/core/domain/MongoDocument.h"
-#include "robomongo/gui/widgets/workarea/BsonTreeItem.h"
 #include "robomongo/core/utils/QtUtils.h"
 #include "robomongo/gui/GuiRegistry.h"
 
-namespace
-{
-    using namespace Robomongo;
-    void parseDocument(BsonTreeItem *root, const mongo::BSONObj &doc)
-    {            
-            mongo::BSONObjIterator iterator(doc);
-            while (iterator.more())
-            {
-                mongo::BSONElement element = iterator.next();                
-                BsonTreeItem *childItemInner = new BsonTreeItem(doc, root);
-                childItemInner->setKey(QtUtils::toQString(std::string(element.fieldName())));
-
-                if (BsonUtils::isArray(element)) {
-                    int itemsCount = element.Array().size();
-                    childItemInner->setValue(QString("Array [%1]").arg(itemsCount));
-                    //parseDocument(childItemInner,element.Obj());  
-                }
-                else if (BsonUtils::isDocument(element)) {
-                    int count = BsonUtils::elementsCount(element.Obj());
-                    childItemInner->setValue(QString("{ %1 fields }").arg(count));
-                   // parseDocument(childItemInner,element.Obj());                    
-                }
-                else {
-                    std::string result;
-                    BsonUtils::buildJsonString(element, result, AppRegistry::instance().settingsManager()->uuidEncoding(), AppRegistry::instance().settingsManager()->timeZone());
-                    childItemInner->setValue(QtUtils::toQString(result));
-                }
-                childItemInner->setType(element.type());
-                if (element.type() == mongo::BinData) {
-                    childItemInner->setBinType(element.binDataType());
-                }
-                root->addChild(childItemInner);
-                //root->setValue(QString("{ %1 fields }").arg(root->childrenCount()));
-            }            
-    }
-}
-
 namespace Robomongo
 {
     BsonTreeModel::BsonTreeModel(const std::vector<MongoDocumentPtr> &documents, QObject *parent) :
         BaseClass(parent),
-        _root(new BsonTreeItem(this))
+        _documents(documents),
+        _documentNodes(documents.size(), -1)
+    {
+    }
+
+    void BsonTreeModel::appendDocuments(const std::vector<MongoDocumentPtr> &documents)
+    {
+        if (documents.empty())
+            return;
+
+        int first = _documents.size();
+        beginInsertRows(QModelIndex(), first, first + documents.size() - 1);
+        _documents.insert(_documents.end(), documents.begin(), documents.end());
+        _documentNodes.resize(_documents.size(), -1);
+        endInsertRows();
+    }
+
+    void BsonTreeModel::replaceDocument(int row, const MongoDocumentPtr &document)
     {
-        for (int i = 0; i < documents.size(); ++i) {
-            MongoDocumentPtr doc = documents[i]; 
-            BsonTreeItem *child = new BsonTreeItem(doc->bsonObj(), _root);
-            parseDocument(child, doc->bsonObj());
-
-            QString idValue;
-            BsonTreeItem *idItem = child->childByKey("_id");
-            if (idItem) {
-                idValue = idItem->value();
+        QModelIndex parent = index(row, 0);
+        int node = documentNode(row);
+
+        int oldCount = childrenCount(node);
+        if (oldCount > 0) {
+            beginRemoveRows(parent, 0, oldCount - 1);
+            freeChildren(node);
+            _nodes[node].childrenCount = 0;
+            endRemoveRows();
+        }
+        _loadedDocuments.remove(node);
+        _documents[row] = document;
+
+        int newCount = BsonUtils::elementsCount(document->bsonObj());
+        if (newCount > 0) {
+            beginInsertRows(parent, 0, newCount - 1);
+            _nodes[node].childrenCount = newCount;
+            endInsertRows();
+        }
+
+        emit dataChanged(parent, index(row, BsonTreeItem::eCountColumns - 1));
+    }
+
+    void BsonTreeModel::removeDocuments(int first, int last)
+    {
+        beginRemoveRows(QModelIndex(), first, last);
+
+        for (int row = first; row <= last; ++row) {
+            int node = _documentNodes[row];
+            if (node < 0)
+                continue;
+
+            freeChildren(node);
+            _loadedDocuments.remove(node);
+            _freeBlocks[1].push_back(node);
+        }
+
+        _documents.erase(_documents.begin() + first, _documents.begin() + last + 1);
+        _documentNodes.erase(_documentNodes.begin() + first, _documentNodes.begin() + last + 1);
+
+        // Nodes refer to documents by row: shift rows of the following documents.
+        // Nodes of free blocks are shifted too, they are reinitialized when reused.
+        int count = last - first + 1;
+        for (std::vector<BsonTreeNode>::iterator it = _nodes.begin(); it != _nodes.end(); ++it) {
+            if (it->document > last) {
+                it->document -= count;
+                if (it->parent < 0)
+                    it->row -= count;
             }
+        }
 
-            child->setKey(QString("(%1) %2").arg(i + 1).arg(idValue));
+        endRemoveRows();
+    }
 
-            int count = BsonUtils::elementsCount(doc->bsonObj());
-            child->setValue(QString("{ %1 fields }").arg(count));
+    BsonTreeItem BsonTreeModel::item(const QModelIndex &index)
+    {
+        QModelIndex source = index;
+        const QAbstractProxyModel *proxy = qobject_cast<const QAbstractProxyModel *>(index.model());
+        if (proxy)
+            source = proxy->mapToSource(index);
+
+        const BsonTreeModel *model = qobject_cast<const BsonTreeModel *>(source.model());
+        if (!model)
+            return BsonTreeItem();
 
-            child->setType(mongo::Object);
-            _root->addChild(child);
+        return model->nodeItem(static_cast<int>(source.internalId()));
+    }
+
+    BsonTreeItem BsonTreeModel::nodeItem(int node) const
+    {
+        const BsonTreeNode &treeNode = _nodes[node];
+        return BsonTreeItem(_documents[treeNode.document]->bsonObj(), treeNode.document, treeNode.offset);
+    }
+
+    int BsonTreeModel::documentNode(int row) const
+    {
+        int node = _documentNodes[row];
+        if (node < 0) {
+            node = allocateNodes(1);
+            BsonTreeNode &treeNode = _nodes[node];
+            treeNode.document = row;
+            treeNode.parent = -1;
+            treeNode.row = row;
+            treeNode.offset = 0;
+            treeNode.firstChild = -1;
+            treeNode.childrenCount = -1;
+            _documentNodes[row] = node;
         }
+        return node;
     }
 
-    void BsonTreeModel::fetchMore(const QModelIndex &parent)
+    int BsonTreeModel::childrenCount(int node) const
     {
-        BsonTreeItem *node = QtUtils::item<BsonTreeItem*>(parent);
-        if (node) {
-            mongo::BSONElement elem = BsonUtils::indexOf(node->root(),parent.row());
-            if (!elem.isNull() && elem.isABSONObj()) {
-                parseDocument(node,elem.Obj());
-            }            
+        BsonTreeNode &treeNode = _nodes[node];
+        if (treeNode.childrenCount < 0) {
+            BsonTreeItem item = nodeItem(node);
+            treeNode.childrenCount = BsonUtils::isDocument(item.type()) ? BsonUtils::elementsCount(item.obj()) : 0;
         }
-        return BaseClass::fetchMore(parent);
+        return treeNode.childrenCount;
     }
 
-    bool BsonTreeModel::canFetchMore(const QModelIndex &parent) const
+    void BsonTreeModel::loadChildren(int node) const
     {
-        BsonTreeItem *node = QtUtils::item<BsonTreeItem*>(parent);
-        if (node && !node->childrenCount()) {
-            return BsonUtils::isDocument(node->type());
+        if (_nodes[node].firstChild >= 0)
+            return;
+
+        if (_nodes[node].parent < 0) {
+            if (_loadedDocuments.size() >= maxLoadedDocuments)
+                discardUnusedDocuments();
+            _loadedDocuments.push_back(node);
+        }
+
+        BsonTreeItem item = nodeItem(node);
+        const char *base = item.superRoot().objdata();
+        int document = _nodes[node].document;
+        int first = allocateNodes(childrenCount(node));
+
+        mongo::BSONObjIterator iterator(item.obj());
+        for (int row = 0; iterator.more(); ++row) {
+            BsonTreeNode &child = _nodes[first + row];
+            child.document = document;
+            child.parent = node;
+            child.row = row;
+            child.offset = static_cast<int>(iterator.next().rawdata() - base);
+            child.firstChild = -1;
+            child.childrenCount = -1;
+        }
+
+        _nodes[node].firstChild = first;
+    }
+
+    /**
+     * @returns position of 'count' contiguous nodes in arena (discarded block
+     * of the same size is reused, if available).
+     */
+    int BsonTreeModel::allocateNodes(int count) const
+    {
+        std::map<int, std::vector<int> >::iterator it = _freeBlocks.find(count);
+        if (it != _freeBlocks.end()) {
+            int first = it->second.back();
+            it->second.pop_back();
+            if (it->second.empty())
+                _freeBlocks.erase(it);
+            return first;
+        }
+
+        int first = _nodes.size();
+        _nodes.resize(first + count);
+        return first;
+    }
+
+    void BsonTreeModel::freeChildren(int node) const
+    {
+        int first = _nodes[node].firstChild;
+        if (first < 0)
+            return;
+
+        int count = _nodes[node].childrenCount;
+        for (int i = 0; i < count; ++i) {
+            freeChildren(first + i);
+        }
+
+        if (count > 0)
+            _freeBlocks[count].push_back(first);
+
+        _nodes[node].firstChild = -1;
+    }
+
+    /**
+     * @brief Discards children of documents, that were loaded earliest, until there is
+     * room for one more loaded document. Documents, that have persistent indexes
+     * in their subtree (expanded or selected by view), are kept: views don't
+     * hold other indexes of collapsed documents.
+     */
+    void BsonTreeModel::discardUnusedDocuments() const
+    {
+        std::set<int> usedDocuments;
+        QModelIndexList persistent = persistentIndexList();
+        for (QModelIndexList::const_iterator it = persistent.begin(); it != persistent.end(); ++it) {
+            if (it->isValid())
+                usedDocuments.insert(_nodes[static_cast<int>(it->internalId())].document);
+        }
+
+        std::list<int>::iterator it = _loadedDocuments.begin();
+        while (it != _loadedDocuments.end() && _loadedDocuments.size() >= maxLoadedDocuments) {
+            if (usedDocuments.count(_nodes[*it].document)) {
+                ++it;
+                continue;
+            }
+            freeChildren(*it);
+            it = _loadedDocuments.erase(it);
         }
-        return false;
     }
 
     bool BsonTreeModel::hasChildren(const QModelIndex &parent) const
     {
-        BsonTreeItem *node = QtUtils::item<BsonTreeItem*>(parent);
-        if (node) {
-            return BsonUtils::isDocument(node->type());
+        if (parent.isValid()) {
+            return BsonUtils::isDocument(nodeItem(static_cast<int>(parent.internalId())).type());
         }
         return true;
     }
 
-    const QIcon &BsonTreeModel::getIcon(BsonTreeItem *item)
+    const QIcon &BsonTreeModel::getIcon(const BsonTreeItem &item)
+    {
+        return getIcon(item.type());
+    }
+
+    const QIcon &BsonTreeModel::getIcon(mongo::BSONType type)
     {
-        switch(item->type()) {
+        switch(type) {
         case mongo::NumberDouble: return GuiRegistry::instance().bsonIntegerIcon();
         case mongo::String: return GuiRegistry::instance().bsonStringIcon();
         case mongo::Object: return GuiRegistry::instance().bsonObjectIcon();
@@ -134,11 +272,7 @@ namespace Robomongo
         if (!index.isValid())
             return result;
 
-        BsonTreeItem *node = QtUtils::item<BsonTreeItem*>(index);
-
-        if (!node)
-            return result;  
-
+        BsonTreeItem node = nodeItem(static_cast<int>(index.internalId()));
         int col = index.column();        
 
         if(role == Qt::DecorationRole && col == BsonTreeItem::eKey ){
@@ -152,20 +286,31 @@ namespace Robomongo
         if (role == Qt::DisplayRole || role == Qt::ToolTipRole) {
             if (col == BsonTreeItem::eKey) {
                 if (role == Qt::DisplayRole) {
-                    result = node->key();
+                    if (node.isDocumentItem()) {
+                        QString idValue;
+                        mongo::BSONElement id = node.superRoot().getField("_id");
+                        if (!id.eoo()) {
+                            idValue = BsonTreeItem::elementValue(id);
+                        }
+                        result = QString("(%1) %2").arg(node.documentRow() + 1).arg(idValue);
+                    }
+                    else {
+                        result = node.key();
+                    }
                 }
             }
             else if (col == BsonTreeItem::eValue) {
-                bool isCut = node->type() == mongo::String ||  node->type() == mongo::Code || node->type() == mongo::CodeWScope;  
+                bool isCut = node.type() == mongo::String ||  node.type() == mongo::Code || node.type() == mongo::CodeWScope;  
+                QString value = node.value();
                 if (role == Qt::ToolTipRole){
-                    result = isCut ? node->value().left(500) : node->value(); 
+                    result = isCut ? value.left(500) : value; 
                 }
                 else{
-                    result = isCut ? node->value().simplified().left(300) : node->value(); 
+                    result = isCut ? value.simplified().left(300) : value; 
                 }
             }
             else if (col == BsonTreeItem::eType) {
-                result = BsonUtils::BSONTypeToString(node->type(),node->binType(),AppRegistry::instance().settingsManager()->uuidEncoding());
+                result = BsonUtils::BSONTypeToString(node.type(),node.binType(),AppRegistry::instance().settingsManager()->uuidEncoding());
             }
         }       
 
@@ -183,13 +328,10 @@ namespace Robomongo
 
     int BsonTreeModel::rowCount(const QModelIndex &parent) const
     {
-        const BsonTreeItem *parentItem=NULL;
-        if (parent.isValid())
-            parentItem = QtUtils::item<BsonTreeItem*>(parent);
-        else
-            parentItem = _root;
+        if (!parent.isValid())
+            return _documents.size();
 
-        return parentItem->childrenCount();
+        return childrenCount(static_cast<int>(parent.internalId()));
     }
 
     int BsonTreeModel::columnCount(const QModelIndex &parent) const
@@ -221,12 +363,9 @@ namespace Robomongo
     {
         QModelIndex result;
         if (index.isValid()) {
-            BsonTreeItem *const childItem = QtUtils::item<BsonTreeItem*const>(index);
-            BsonTreeItem *const parentItem = static_cast<BsonTreeItem*const>(childItem->parent());
-            if (parentItem && parentItem!=_root) {
-                BsonTreeItem *const grandParent = static_cast<BsonTreeItem*const>(parentItem->parent());
-                int row = grandParent->indexOf(parentItem);
-                result= createIndex(row, 0, parentItem);
+            int parentNode = _nodes[static_cast<int>(index.internalId())].parent;
+            if (parentNode >= 0) {
+                result = createIndex(_nodes[parentNode].row, 0, static_cast<quint32>(parentNode));
             }
         }
         return result;
@@ -236,39 +375,16 @@ namespace Robomongo
     {
         QModelIndex index;
         if (hasIndex(row, column, parent)) {
-            const BsonTreeItem * parentItem=NULL;
+            int node = -1;
             if (!parent.isValid()) {
-                parentItem = _root;
+                node = documentNode(row);
             } else {
-                parentItem = QtUtils::item<BsonTreeItem*>(parent);
-            }
-
-            BsonTreeItem *childItem = parentItem->child(row);
-            if (childItem) {
-                index = createIndex(row, column, childItem);
+                int parentNode = static_cast<int>(parent.internalId());
+                loadChildren(parentNode);
+                node = _nodes[parentNode].firstChild + row;
             }
+            index = createIndex(row, column, static_cast<quint32>(node));
         }
         return index;
     }
-
-    void BsonTreeModel::insertItem(BsonTreeItem *parent, BsonTreeItem *children)
-    {
-        QModelIndex index = createIndex(0,0,parent);
-        unsigned child_count = parent->childrenCount();
-        beginInsertRows(index,child_count,child_count);
-        parent->addChild(children);
-        endInsertRows();
-    }
-
-    void BsonTreeModel::removeitem(BsonTreeItem *children)
-    {
-        BsonTreeItem *parent = static_cast<BsonTreeItem *>(children->parent());
-        if (parent) {
-            QModelIndex index = createIndex(0, 0, parent);
-            int row = parent->indexOf(children);
-            beginRemoveRows(index, row, row);
-            parent->removeChild(children);
-            endRemoveRows();
-        }
-    }
 }
@@ -1,19 +1,38 @@
 #pragma once
+#include <list>
+#include <map>
 #include <vector>
 #include <QAbstractItemModel>
+#include <mongo/bson/bsontypes.h>
 #include "robomongo/core/Core.h"
+#include "robomongo/gui/widgets/workarea/BsonTreeItem.h"
 
 namespace Robomongo
 {
-    class BsonTreeItem;
-
+    /**
+     * @brief Tree model of query results. Model keeps list of documents and arena
+     * of BsonTreeNode's: node of document is created when view requests index of
+     * its row, nodes of fields are created when view requests children of document,
+     * and text of cells is built in data(). Internal id of index is position of
+     * node in arena. Children of documents, that are not referenced by view
+     * (collapsed and not selected), are discarded when number of loaded documents
+     * exceeds maxLoadedDocuments, and their place in arena is reused.
+     */
     class BsonTreeModel : public QAbstractItemModel
     {
         Q_OBJECT
 
     public:
         typedef QAbstractItemModel BaseClass;
-        static const QIcon &getIcon(BsonTreeItem *item);
+        static const QIcon &getIcon(const BsonTreeItem &item);
+        static const QIcon &getIcon(mongo::BSONType type);
+
+        /**
+         * @brief Returns item of index of BsonTreeModel or of proxy model, that
+         * wraps BsonTreeModel (null item, if index doesn't point to item).
+         */
+        static BsonTreeItem item(const QModelIndex &index);
+
         explicit BsonTreeModel(const std::vector<MongoDocumentPtr> &documents,QObject *parent = 0);
         QVariant data(const QModelIndex &index, int role) const;
 
@@ -25,13 +44,56 @@ namespace Robomongo
         virtual QModelIndex index(int row, int column, const QModelIndex &parent= QModelIndex()) const;
         virtual QModelIndex parent(const QModelIndex& index) const;
 
-        void insertItem(BsonTreeItem *parent, BsonTreeItem *children);
-        void removeitem(BsonTreeItem *children);
+        /**
+         * @brief Appends documents to the end of the model (used when
+         * query results are streamed in parts).
+         */
+        void appendDocuments(const std::vector<MongoDocumentPtr> &documents);
+
+        /**
+         * @brief Replaces document of 'row' (i.e. after it was edited):
+         * fields of old document are removed and new ones are created on demand.
+         */
+        void replaceDocument(int row, const MongoDocumentPtr &document);
+
+        /**
+         * @brief Removes documents of rows [first, last].
+         */
+        void removeDocuments(int first, int last);
 
-        virtual void fetchMore(const QModelIndex &parent);
-        virtual bool canFetchMore(const QModelIndex &parent) const;
         virtual bool hasChildren(const QModelIndex &parent = QModelIndex()) const;
+
     protected:
-        BsonTreeItem *const _root;
+        enum { maxLoadedDocuments = 64 };
+
+        BsonTreeItem nodeItem(int node) const;
+        int documentNode(int row) const;
+        int childrenCount(int node) const;
+        void loadChildren(int node) const;
+        int allocateNodes(int count) const;
+        void freeChildren(int node) const;
+        void discardUnusedDocuments() const;
+
+        std::vector<MongoDocumentPtr> _documents;
+
+        /**
+         * @brief Arena of nodes.
+         */
+        mutable std::vector<BsonTreeNode> _nodes;
+
+        /**
+         * @brief Positions of document nodes in arena (-1 for rows, that were not requested yet).
+         */
+        mutable std::vector<int> _documentNodes;
+
+        /**
+         * @brief Document nodes with loaded children, in order of loading.
+         */
+        mutable std::list<int> _loadedDocuments;
+
+        /**
+         * @brief Discarded blocks of children, that can be reused (size -> positions).
+         */
+        mutable std::map<int, std::vector<int> > _freeBlocks;
     };
 }
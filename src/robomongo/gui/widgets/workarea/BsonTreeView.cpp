@@ -5,7 +5,7 @@
 #include <QMenu>
 #include <QKeyEvent>
 
-#include "robomongo/gui/widgets/workarea/BsonTreeItem.h"
+#include "robomongo/gui/widgets/workarea/BsonTreeModel.h"
 
 #include "robomongo/gui/GuiRegistry.h"
 #include "robomongo/core/utils/QtUtils.h"
@@ -55,11 +55,11 @@ namespace Robomongo
         else {
 
             QModelIndex selectedInd = selectedIndex();
-            BsonTreeItem *documentItem = QtUtils::item<BsonTreeItem*>(selectedInd);
+            BsonTreeItem documentItem = BsonTreeModel::item(selectedInd);
 
             QMenu menu(this);
             bool isSimple = false;
-            if (documentItem) {
+            if (!documentItem.isNull()) {
                 isSimple = detail::isSimpleType(documentItem);
                 if (detail::isDocumentType(documentItem)) {
                     menu.addAction(_expandRecursive);
@@ -91,11 +91,12 @@ namespace Robomongo
     {
         if (index.isValid()) {
             BaseClass::expand(index);
-            BsonTreeItem *item = QtUtils::item<BsonTreeItem*>(index);
-            for (unsigned i = 0; i < item->childrenCount(); ++i) {
-                BsonTreeItem *tritem = item->child(i);
-                if (tritem && detail::isDocumentType(tritem)) {
-                    expandNode(model()->index(i, 0, index));
+            int count = model()->rowCount(index);
+            for (int i = 0; i < count; ++i) {
+                QModelIndex child = model()->index(i, 0, index);
+                BsonTreeItem tritem = BsonTreeModel::item(child);
+                if (!tritem.isNull() && detail::isDocumentType(tritem)) {
+                    expandNode(child);
                 }
             }
         }
@@ -105,11 +106,12 @@ namespace Robomongo
     {
         if (index.isValid()) {
             BaseClass::collapse(index);
-            BsonTreeItem *item = QtUtils::item<BsonTreeItem*>(index);
-            for (unsigned i = 0; i < item->childrenCount(); ++i) {
-                BsonTreeItem *tritem = item->child(i);
-                if (tritem && detail::isDocumentType(tritem)) {
-                    collapseNode(model()->index(i, 0, index));
+            int count = model()->rowCount(index);
+            for (int i = 0; i < count; ++i) {
+                QModelIndex child = model()->index(i, 0, index);
+                BsonTreeItem tritem = BsonTreeModel::item(child);
+                if (!tritem.isNull() && detail::isDocumentType(tritem)) {
+                    collapseNode(child);
                 }
             }
         }
@@ -1,17 +1,93 @@
 #include "robomongo/gui/widgets/workarea/JsonPrepareThread.h"
 
-#include <QHBoxLayout>
+#include <QMutex>
+#include <QRunnable>
+#include <QThreadPool>
+#include <QWaitCondition>
+#include <boost/lexical_cast.hpp>
 
 #include "robomongo/core/domain/MongoDocument.h"
 #include "robomongo/core/utils/BsonUtils.h"
 #include "robomongo/core/utils/QtUtils.h"
 
+namespace
+{
+    using namespace Robomongo;
+
+    struct JsonChunk
+    {
+        JsonChunk() : ready(false) { }
+        QString json;
+        bool ready;
+    };
+
+    /**
+     * @brief Renders documents [from, till) into JSON chunk and notifies
+     * waiting thread, when chunk is ready (even if rendering was stopped).
+     */
+    class JsonChunkTask : public QRunnable
+    {
+    public:
+        JsonChunkTask(const std::vector<MongoDocumentPtr> &documents, size_t from, size_t till, int firstPosition,
+                      UUIDEncoding uuidEncoding, SupportedTimes timeZone, const volatile bool &stop,
+                      JsonChunk &chunk, QMutex &mutex, QWaitCondition &chunkReady) :
+            _documents(documents),
+            _from(from),
+            _till(till),
+            _firstPosition(firstPosition),
+            _uuidEncoding(uuidEncoding),
+            _timeZone(timeZone),
+            _stop(stop),
+            _chunk(chunk),
+            _mutex(mutex),
+            _chunkReady(chunkReady) { }
+
+        virtual void run()
+        {
+            std::string buffer;
+            for (size_t i = _from; i < _till && !_stop; ++i) {
+                int position = _firstPosition + static_cast<int>(i); // 1-based numbering to match tree & table views
+                if (position == 1) {
+                    buffer += "/* 1 */\n";
+                } else {
+                    buffer += "\n\n/* ";
+                    buffer += boost::lexical_cast<std::string>(position);
+                    buffer += " */\n";
+                }
+
+                mongo::BSONObj obj = _documents[i]->bsonObj();
+                BsonUtils::appendJsonString(buffer, obj, mongo::TenGen, 1, _uuidEncoding, _timeZone);
+            }
+
+            QString json = _stop ? QString() : QtUtils::toQString(buffer);
+
+            QMutexLocker lock(&_mutex);
+            _chunk.json = json;
+            _chunk.ready = true;
+            _chunkReady.wakeAll();
+        }
+
+    private:
+        const std::vector<MongoDocumentPtr> &_documents;
+        const size_t _from;
+        const size_t _till;
+        const int _firstPosition;
+        const UUIDEncoding _uuidEncoding;
+        const SupportedTimes _timeZone;
+        const volatile bool &_stop;
+        JsonChunk &_chunk;
+        QMutex &_mutex;
+        QWaitCondition &_chunkReady;
+    };
+}
+
 namespace Robomongo
 {
-    JsonPrepareThread::JsonPrepareThread(const std::vector<MongoDocumentPtr> &bsonObjects, UUIDEncoding uuidEncoding, SupportedTimes timeZone)
+    JsonPrepareThread::JsonPrepareThread(const std::vector<MongoDocumentPtr> &bsonObjects, UUIDEncoding uuidEncoding, SupportedTimes timeZone, int firstPosition)
         :_bsonObjects(bsonObjects),
         _uuidEncoding(uuidEncoding),
         _timeZone(timeZone),
+        _firstPosition(firstPosition),
         _stop(false)
     {
     }
@@ -23,33 +99,39 @@ namespace Robomongo
 
     void JsonPrepareThread::run()
     {
-        int position = 1; // 1-based numbering to match tree & table views
-        for(std::vector<MongoDocumentPtr>::const_iterator it = _bsonObjects.begin();it!=_bsonObjects.end();++it)
-        {
-            MongoDocumentPtr doc = *it;
-            mongo::StringBuilder sb;
-            if (position == 1)
-                sb << "/* 1 */\n";
-            else
-                sb << "\n\n/* " << position << " */\n";
+        size_t count = _bsonObjects.size();
+        std::vector<JsonChunk> chunks((count + chunkDocuments - 1) / chunkDocuments);
 
-            mongo::BSONObj obj = doc->bsonObj();
-            std::string stdJson = BsonUtils::jsonString(obj, mongo::TenGen, 1, _uuidEncoding, _timeZone);
+        QMutex mutex;
+        QWaitCondition chunkReady;
 
-            if (_stop)
-                break;
+        // Chunks are rendered in parallel, this thread only emits them in order
+        QThreadPool pool;
+        pool.setMaxThreadCount(qMax(1, QThread::idealThreadCount()));
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            size_t from = i * chunkDocuments;
+            size_t till = qMin(count, from + chunkDocuments);
+            pool.start(new JsonChunkTask(_bsonObjects, from, till, _firstPosition, _uuidEncoding, _timeZone, _stop,
+                                         chunks[i], mutex, chunkReady));
+        }
 
-            sb << stdJson;
-            QString json = QtUtils::toQString(sb.str());
+        for (std::vector<JsonChunk>::iterator it = chunks.begin(); it != chunks.end(); ++it) {
+            QString json;
+            {
+                QMutexLocker lock(&mutex);
+                while (!it->ready)
+                    chunkReady.wait(&mutex);
+                json.swap(it->json);
+            }
 
             if (_stop)
                 break;
 
             emit partReady(json);
-
-            position++;
         }
 
+        // Tasks reference chunks and documents of this thread
+        pool.waitForDone();
         emit done();
     }
 }
@@ -17,10 +17,16 @@ namespace Robomongo
         Q_OBJECT
 
     public:
+        /**
+         * @brief Documents are rendered in chunks of this size by thread pool,
+         * every chunk is emitted (in order) as single part.
+         */
+        enum{chunkDocuments = 256};
+
         /*
         ** Constructor
         */
-        JsonPrepareThread(const std::vector<MongoDocumentPtr> &bsonObjects, UUIDEncoding uuidEncoding, SupportedTimes timeZone);
+        JsonPrepareThread(const std::vector<MongoDocumentPtr> &bsonObjects, UUIDEncoding uuidEncoding, SupportedTimes timeZone, int firstPosition = 1);
         void stop();
    Q_SIGNALS:
         /**
@@ -29,7 +35,7 @@ namespace Robomongo
         void done();
 
         /**
-         * @brief Signals when json part is ready
+         * @brief Signals when json part (chunk of documents) is ready
          */
         void partReady(const QString &part);
 
@@ -46,6 +52,11 @@ namespace Robomongo
         const std::vector<MongoDocumentPtr> _bsonObjects;
         const UUIDEncoding _uuidEncoding;
         const SupportedTimes _timeZone;
+
+        /*
+        ** Number of the first document (1-based), used when results are rendered in parts
+        */
+        const int _firstPosition;
         volatile bool _stop;
     };
 }
@@ -1,5 +1,6 @@
 #include "robomongo/gui/widgets/workarea/OutputItemContentWidget.h"
 
+#include <algorithm>
 #include <QVBoxLayout>
 #include <Qsci/qscilexerjavascript.h>
 
@@ -7,6 +8,10 @@
 #include "robomongo/core/settings/SettingsManager.h"
 #include "robomongo/core/utils/QtUtils.h"
 #include "robomongo/core/domain/MongoShell.h"
+#include "robomongo/core/domain/MongoServer.h"
+#include "robomongo/core/domain/MongoDocument.h"
+#include "robomongo/core/events/MongoEvents.h"
+#include "robomongo/core/EventBus.h"
 
 #include "robomongo/gui/widgets/workarea/OutputWidget.h"
 #include "robomongo/gui/widgets/workarea/OutputItemHeaderWidget.h"
@@ -28,6 +33,7 @@ namespace Robomongo
         _textView(NULL),
         _bsonTreeview(NULL),
         _thread(NULL),
+        _jsonPreparedCount(0),
         _bsonTable(NULL),
         _isTextModeSupported(true),
         _isTreeModeSupported(false),
@@ -54,6 +60,7 @@ namespace Robomongo
         _textView(NULL),
         _bsonTreeview(NULL),
         _thread(NULL),
+        _jsonPreparedCount(0),
         _bsonTable(NULL),
         _isTextModeSupported(true),
         _isTreeModeSupported(true),
@@ -89,6 +96,12 @@ namespace Robomongo
             if(!_queryInfo._limit){
             _queryInfo._limit=50;
             }
+
+            // Views are patched with results of edits instead of re-querying
+            MongoServer *server = _shell->server();
+            AppRegistry::instance().bus()->subscribe(this, InsertDocumentsResponse::Type, server);
+            AppRegistry::instance().bus()->subscribe(this, RemoveDocumentsResponse::Type, server);
+            AppRegistry::instance().bus()->subscribe(this, UpdateDocumentResponse::Type, server);
         }
 
         _header->setTime(QString("%1 sec.").arg(secs));
@@ -180,6 +193,12 @@ namespace Robomongo
         _isFirstPartRendered = false;
         markUninitialized();
 
+        if (_thread) {
+            _thread->stop();
+            _thread = NULL;
+        }
+        _jsonPreparedCount = 0;
+
         if (_bsonTable) {
             _stack->removeWidget(_bsonTable);
             delete _bsonTable;
@@ -200,6 +219,104 @@ namespace Robomongo
         configureModel();
     }
 
+    void OutputItemContentWidget::append(const std::vector<MongoDocumentPtr> &documents)
+    {
+        if (documents.empty())
+            return;
+
+        _documents.insert(_documents.end(), documents.begin(), documents.end());
+
+        // Tree and table views are updated through model signals
+        _mod->appendDocuments(documents);
+
+        // If JSON is being prepared now, new documents will be
+        // picked up when current thread is done
+        if (_isTextModeInitialized && !_thread)
+            prepareJson();
+    }
+
+    void OutputItemContentWidget::handle(InsertDocumentsResponse *event)
+    {
+        if (!isOwnNamespace(event->ns()))
+            return;
+
+        const std::vector<mongo::BSONObj> &documents = event->documents();
+        // Documents are appended only to the last page (page, that is not full):
+        // otherwise they belong to one of the next pages
+        size_t capacity = std::max(pageSize(), 0);
+        bool canAppend = !event->isError() && canPatchDocuments() && _documents.size() < capacity &&
+                         _documents.size() + documents.size() <= capacity;
+
+        // Documents without _id get it on the server, so local copy would differ
+        for (std::vector<mongo::BSONObj>::const_iterator it = documents.begin(); canAppend && it != documents.end(); ++it) {
+            canAppend = it->hasField("_id");
+        }
+
+        if (!canAppend) {
+            refresh(_queryInfo._skip, _queryInfo._batchSize);
+            return;
+        }
+
+        std::vector<MongoDocumentPtr> inserted = MongoDocument::fromBsonObj(documents);
+        _documents.insert(_documents.end(), inserted.begin(), inserted.end());
+        _mod->appendDocuments(inserted);
+        rebuildJson();
+    }
+
+    void OutputItemContentWidget::handle(RemoveDocumentsResponse *event)
+    {
+        if (!isOwnNamespace(event->ns()))
+            return;
+
+        if (event->isError()) {
+            refresh(_queryInfo._skip, _queryInfo._batchSize);
+            return;
+        }
+
+        std::vector<int> rows;
+        const std::vector<mongo::BSONObj> &ids = event->ids();
+        for (std::vector<mongo::BSONObj>::const_iterator it = ids.begin(); it != ids.end(); ++it) {
+            int row = documentRow(it->firstElement());
+            if (row >= 0)
+                rows.push_back(row);
+        }
+
+        if (rows.empty())
+            return;
+
+        // Remove from the end, so that rows of remaining documents stay valid
+        std::sort(rows.begin(), rows.end());
+        rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+        for (std::vector<int>::const_reverse_iterator it = rows.rbegin(); it != rows.rend(); ++it) {
+            _mod->removeDocuments(*it, *it);
+            _documents.erase(_documents.begin() + *it);
+        }
+        rebuildJson();
+    }
+
+    void OutputItemContentWidget::handle(UpdateDocumentResponse *event)
+    {
+        if (!isOwnNamespace(event->ns()))
+            return;
+
+        mongo::BSONElement id = event->original().getField("_id");
+        int row = id.eoo() ? -1 : documentRow(id);
+        if (row < 0)
+            return;
+
+        mongo::BSONObj edited = event->edited();
+        mongo::BSONElement editedId = edited.getField("_id");
+        if (event->isError() || !canPatchDocuments() || editedId.eoo() || !id.valuesEqual(editedId)) {
+            refresh(_queryInfo._skip, _queryInfo._batchSize);
+            return;
+        }
+
+        MongoDocumentPtr document = MongoDocument::fromBsonObj(edited);
+        _documents[row] = document;
+        _mod->replaceDocument(row, document);
+        rebuildJson();
+    }
+
     void OutputItemContentWidget::showText()
     {
         _viewMode = Text;
@@ -216,10 +333,8 @@ namespace Robomongo
             else {
                 if (_documents.size() > 0) {
                     _textView->sciScintilla()->setText("Loading...");
-                    _thread = new JsonPrepareThread(_documents, AppRegistry::instance().settingsManager()->uuidEncoding(), AppRegistry::instance().settingsManager()->timeZone());
-                    VERIFY(connect(_thread, SIGNAL(partReady(const QString&)), this, SLOT(jsonPartReady(const QString&))));
-                    VERIFY(connect(_thread, SIGNAL(finished()), _thread, SLOT(deleteLater())));
-                    _thread->start();
+                    _jsonPreparedCount = 0;
+                    prepareJson();
                 }
             }
             _stack->addWidget(_textView);
@@ -335,6 +450,92 @@ namespace Robomongo
         }
     }
     
+    void OutputItemContentWidget::jsonPrepared()
+    {
+        JsonPrepareThread *thread = qobject_cast<JsonPrepareThread *>(sender());
+        if (thread != _thread)
+            return;
+
+        _thread = NULL;
+
+        // Documents that were appended while previous thread was running
+        if (_isTextModeInitialized && _jsonPreparedCount < _documents.size())
+            prepareJson();
+    }
+
+    /**
+     * @brief Starts JsonPrepareThread for documents that were not rendered yet.
+     */
+    void OutputItemContentWidget::prepareJson()
+    {
+        std::vector<MongoDocumentPtr> documents(_documents.begin() + _jsonPreparedCount, _documents.end());
+        _thread = new JsonPrepareThread(documents, AppRegistry::instance().settingsManager()->uuidEncoding(),
+            AppRegistry::instance().settingsManager()->timeZone(), _jsonPreparedCount + 1);
+        _jsonPreparedCount = _documents.size();
+
+        VERIFY(connect(_thread, SIGNAL(partReady(const QString&)), this, SLOT(jsonPartReady(const QString&))));
+        VERIFY(connect(_thread, SIGNAL(done()), this, SLOT(jsonPrepared())));
+        VERIFY(connect(_thread, SIGNAL(finished()), _thread, SLOT(deleteLater())));
+        _thread->start();
+    }
+
+    /**
+     * @brief Renders text view again after documents were changed in place.
+     */
+    void OutputItemContentWidget::rebuildJson()
+    {
+        if (!_isTextModeInitialized)
+            return;
+
+        if (_thread) {
+            _thread->stop();
+            _thread = NULL;
+        }
+
+        _text.clear();
+        _isFirstPartRendered = false;
+        _jsonPreparedCount = 0;
+        _textView->sciScintilla()->setText("");
+        if (_documents.size() > 0)
+            prepareJson();
+    }
+
+    bool OutputItemContentWidget::isOwnNamespace(const MongoNamespace &ns) const
+    {
+        return _queryInfo._info.isValid() && ns.toString() == _queryInfo._info._ns.toString();
+    }
+
+    bool OutputItemContentWidget::canPatchDocuments() const
+    {
+        return !_queryInfo._special && _queryInfo._query.isEmpty() && _queryInfo._fields.isEmpty();
+    }
+
+    /**
+     * @brief Number of documents, that current page can show: batch size,
+     * bounded by the rest of limit of the text query (as in refresh()).
+     */
+    int OutputItemContentWidget::pageSize() const
+    {
+        int size = _queryInfo._batchSize;
+        if (_initialLimit != 0)
+            size = std::min(size, _initialLimit - (_queryInfo._skip - _initialSkip));
+
+        return size;
+    }
+
+    /**
+     * @brief Returns row of document with given _id or -1, if it is not in the view.
+     */
+    int OutputItemContentWidget::documentRow(const mongo::BSONElement &id) const
+    {
+        for (size_t row = 0; row < _documents.size(); ++row) {
+            mongo::BSONElement documentId = _documents[row]->bsonObj().getField("_id");
+            if (!documentId.eoo() && documentId.valuesEqual(id))
+                return static_cast<int>(row);
+        }
+        return -1;
+    }
+
     BsonTreeModel *OutputItemContentWidget::configureModel()
     {
         delete _mod;
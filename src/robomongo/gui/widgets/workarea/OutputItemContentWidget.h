@@ -18,6 +18,9 @@ namespace Robomongo
     class MongoShell;
     class OutputItemHeaderWidget;
     class OutputWidget;
+    class InsertDocumentsResponse;
+    class RemoveDocumentsResponse;
+    class UpdateDocumentResponse;
 
     class OutputItemContentWidget : public QWidget
     {
@@ -30,6 +33,11 @@ namespace Robomongo
         int _initialSkip;
         int _initialLimit;
         void update(const MongoQueryInfo &inf,const std::vector<MongoDocumentPtr> &documents);
+
+        /**
+         * @brief Appends next part of streamed query results to all views.
+         */
+        void append(const std::vector<MongoDocumentPtr> &documents);
         bool isTextModeSupported() const { return _isTextModeSupported; }
         bool isTreeModeSupported() const { return _isTreeModeSupported; }
         bool isCustomModeSupported() const { return _isCustomModeSupported; }
@@ -48,9 +56,13 @@ namespace Robomongo
         void showTree();        
         void showTable();
         void showCustom();
+        void handle(InsertDocumentsResponse *event);
+        void handle(RemoveDocumentsResponse *event);
+        void handle(UpdateDocumentResponse *event);
 
     private Q_SLOTS:
         void jsonPartReady(const QString &json);
+        void jsonPrepared();
         void refresh(int skip, int batchSize);
         void paging_rightClicked(int skip, int batchSize);
         void paging_leftClicked(int skip, int limit);      
@@ -59,6 +71,17 @@ namespace Robomongo
         void setup(double secs);
         FindFrame *configureLogText();
         BsonTreeModel *configureModel();
+        void prepareJson();
+        void rebuildJson();
+        bool isOwnNamespace(const MongoNamespace &ns) const;
+
+        /**
+         * @brief Tests whether documents can be changed in place, i.e. query has
+         * no filter, sort or projection, that can exclude or move them.
+         */
+        bool canPatchDocuments() const;
+        int pageSize() const;
+        int documentRow(const mongo::BSONElement &id) const;
 
         FindFrame *_textView;
         BsonTreeView *_bsonTreeview;
@@ -73,6 +96,7 @@ namespace Robomongo
 
         QStackedWidget *_stack;
         JsonPrepareThread *_thread;
+        size_t _jsonPreparedCount; // number of documents passed to JsonPrepareThread
 
         MongoShell *_shell;
         OutputItemHeaderWidget *_header;
@@ -71,6 +71,15 @@ namespace Robomongo
         output->refreshOutputItem();
     }
 
+    void OutputWidget::appendPart(int partIndex, const std::vector<MongoDocumentPtr> &documents)
+    {
+        if (partIndex < 0 || partIndex >= _splitter->count())
+            return;
+
+        OutputItemContentWidget *output = (OutputItemContentWidget *) _splitter->widget(partIndex);
+        output->append(documents);
+    }
+
     void OutputWidget::toggleOrientation()
     {
         if (_splitter->orientation() == Qt::Horizontal)
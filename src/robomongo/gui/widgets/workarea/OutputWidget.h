@@ -23,6 +23,7 @@ namespace Robomongo
 
         void present(MongoShell *shell, const std::vector<MongoShellResult> &documents);
         void updatePart(int partIndex, const MongoQueryInfo &queryInfo, const std::vector<MongoDocumentPtr> &documents);
+        void appendPart(int partIndex, const std::vector<MongoDocumentPtr> &documents);
         void toggleOrientation();
 
         void enterTreeMode();
@@ -193,8 +193,13 @@ namespace Robomongo
 
     void QueryWidget::handle(DocumentListLoadedEvent *event)
     {
-        hideProgress();        
-        _viewer->updatePart(event->resultIndex(), event->queryInfo(), event->documents()); // this should be in viewer, subscribed to ScriptExecutedEvent
+        hideProgress();
+
+        // this should be in viewer, subscribed to ScriptExecutedEvent
+        if (event->isFirstPart())
+            _viewer->updatePart(event->resultIndex(), event->queryInfo(), event->documents());
+        else
+            _viewer->appendPart(event->resultIndex(), event->documents());
     }
 
     void QueryWidget::handle(ScriptExecutedEvent *event)
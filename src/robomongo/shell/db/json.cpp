@@ -42,15 +42,16 @@ namespace Robomongo {
 #define CONTROL "\a\b\f\n\r\t\v"
 #define JOPTIONS "gims"
 
-    // Size hints given to char vectors
+    // Size hints given to char vectors.  Kept small, because strings are
+    // created for every field and value; longer strings grow on demand.
     enum {
         ID_RESERVE_SIZE = 64,
-        PAT_RESERVE_SIZE = 4096,
-        OPT_RESERVE_SIZE = 64,
-        FIELD_RESERVE_SIZE = 4096,
-        STRINGVAL_RESERVE_SIZE = 4096,
-        BINDATA_RESERVE_SIZE = 4096,
-        BINDATATYPE_RESERVE_SIZE = 4096,
+        PAT_RESERVE_SIZE = 64,
+        OPT_RESERVE_SIZE = 8,
+        FIELD_RESERVE_SIZE = 32,
+        STRINGVAL_RESERVE_SIZE = 64,
+        BINDATA_RESERVE_SIZE = 64,
+        BINDATATYPE_RESERVE_SIZE = 8,
         NS_RESERVE_SIZE = 64
     };
 
@@ -69,6 +70,9 @@ namespace Robomongo {
     JParse::JParse(const char* str)
         : _buf(str), _input(str), _input_end(str + strlen(str)) {}
 
+    JParse::JParse(const char* str, size_t length)
+        : _buf(str), _input(str), _input_end(str + length) {}
+
     Status JParse::parseError(const StringData& msg) {
         std::ostringstream ossmsg;
         ossmsg << msg;
@@ -316,17 +320,19 @@ namespace Robomongo {
             if (valueRet != Status::OK()) {
                 return valueRet;
             }
+            // Buffer of the first field name is reused for the rest of fields:
+            // value() copies the name into builder before parsing nested values.
+            std::string& nextFieldName = firstField;
             while (accept(COMMA)) {
-                std::string fieldName;
-                fieldName.reserve(FIELD_RESERVE_SIZE);
-                Status fieldRet = field(&fieldName);
+                nextFieldName.clear();
+                Status fieldRet = field(&nextFieldName);
                 if (fieldRet != Status::OK()) {
                     return fieldRet;
                 }
                 if (!accept(COLON)) {
                     return parseError("Expecting ':'");
                 }
-                Status valueRet = value(fieldName, *objBuilder);
+                Status valueRet = value(nextFieldName, *objBuilder);
                 if (valueRet != Status::OK()) {
                     return valueRet;
                 }
@@ -1193,6 +1199,39 @@ namespace Robomongo {
         return builder.obj();
     }
 
+    bool JParse::atEnd() {
+        while (_input < _input_end && isspace(*_input)) {
+            ++_input;
+        }
+        return _input >= _input_end;
+    }
+
+    Status JParse::nextObject(BSONObj* result) {
+        MONGO_JSON_DEBUG("offset: " << offset());
+        _objBuf.reset();
+        BSONObjBuilder builder(_objBuf);
+        Status ret = object("UNUSED", builder, false);
+        if (ret != Status::OK()) {
+            return ret;
+        }
+        *result = builder.done().getOwned();
+        return Status::OK();
+    }
+
+    void fromjson(const char* str, size_t length, std::vector<BSONObj>& result) {
+        JParse jparse(str, length);
+        while (!jparse.atEnd()) {
+            BSONObj obj;
+            Status ret = jparse.nextObject(&obj);
+            if (ret != Status::OK()) {
+                ostringstream message;
+                message << "code " << ret.code() << ": " << ret.codeString() << ": " << ret.reason();
+                throw ParseMsgAssertionException(16619, message.str(), jparse.offset(), ret.reason());
+            }
+            result.push_back(obj);
+        }
+    }
+
     BSONObj fromjson(const std::string& str) {
         return fromjson( str.c_str() );
     }
@@ -17,8 +17,10 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "mongo/bson/bsonobj.h"
+#include "mongo/bson/util/builder.h"
 #include "mongo/base/status.h"
 #include "robomongo/core/Enums.h"
 
@@ -43,6 +45,17 @@ namespace Robomongo {
     /** @param len will be size of JSON object in text chars. */
     BSONObj fromjson(const char* str, int* len=NULL);
 
+    /**
+     * Parses all JSON objects, separated by whitespace, from the first
+     * 'length' chars of 'str' in one pass and appends them to 'result'.
+     * Char at 'length' should not continue the last token (numbers are read
+     * with strtod), null terminated buffer like std::string::c_str() is fine.
+     *
+     * @throws MsgAssertionException if parsing fails.  Offset of assertion is
+     * counted from the beginning of 'str'.
+     */
+    void fromjson(const char* str, size_t length, std::vector<BSONObj>& result);
+
     /**
      * Parser class.  A BSONObj is constructed incrementally by passing a
      * BSONObjBuilder to the recursive parsing methods.  The grammar for the
@@ -52,6 +65,24 @@ namespace Robomongo {
         public:
             explicit JParse(const char*);
 
+            /**
+             * Parser of the first 'length' chars of buffer (see _input_end
+             * about char at 'length').
+             */
+            JParse(const char*, size_t length);
+
+            /**
+             * Skips whitespace.
+             * @return true if there is no more input
+             */
+            bool atEnd();
+
+            /**
+             * Parses next top level object in our stream.  All objects are
+             * built in the same buffer, result is owned copy of exact size.
+             */
+            Status nextObject(BSONObj* result);
+
             /*
              * Notation: All-uppercase symbols denote non-terminals; all other
              * symbols are literals.
@@ -404,6 +435,11 @@ namespace Robomongo {
             const char* const _buf;
             const char* _input;
             const char* const _input_end;
+
+            /*
+             * _objBuf - buffer that is reused by nextObject() for every object
+             */
+            BufBuilder _objBuf;
     };
 
 }  /* namespace Robomongo */
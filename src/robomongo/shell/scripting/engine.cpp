@@ -30,6 +30,44 @@
 namespace mongo {
 #ifdef ROBOMONGO
     volatile bool Scope::_interruptFlag = false;
+
+    void Scope::ShellOutput::resetType() {
+        type = "";
+        finished = false;
+    }
+
+    void Scope::ShellOutput::reset() {
+        objects.clear();
+        logs.str("");
+        resetType();
+    }
+
+    void Scope::ShellOutput::addObject(const BSONObj &obj) {
+        if (finished) {
+            resetType();
+        }
+
+        objects.push_back(obj);
+    }
+
+    void Scope::ShellOutput::begin(const std::string &requestType) {
+        if (objects.size() != 0) {
+            resetType();
+            return;
+        }
+
+        if (finished) {
+            resetType();
+            return;
+        }
+
+        type = requestType;
+        finished = false;
+    }
+
+    void Scope::ShellOutput::end() {
+        finished = true;
+    }
 #endif
 
     long long Scope::_lastVersion = 1;
@@ -31,51 +31,10 @@
 #include "mongo/util/mongoutils/str.h"
 
 #ifdef ROBOMONGO
-std::vector<mongo::BSONObj> __objects;
-std::string __type;     // type of request
-bool __finished;        // typed request is finished
-std::stringstream __logs;
-
-void robomongo_reset_type() {
-    __type = "";
-    __finished = false;
-}
-
-void robomongo_reset() {
-    __objects.clear();
-    __logs.str("");
-    robomongo_reset_type();
-}
-
-void robomongo_add_bsonobj(const mongo::BSONObj &obj) {
-    if (__finished) {
-        robomongo_reset_type();
-    }
-
-    __objects.push_back(obj);
-}
-
-void robomongo_begin(const std::string &type) {
-    if (__objects.size() != 0) {
-        robomongo_reset_type();
-        return;
-    }
-
-    if (__finished) {
-        robomongo_reset_type();
-        return;
-    }
-
-    __type = type;
-    __finished = false;
-}
-
-void robomongo_end() {
-    __finished = true;
-}
-
+#include "robomongo/core/engine/StatementSplitter.h"
 #endif
 
+
 namespace mongo {
 
     /* used to make the logging not overly chatty in the mongo shell. */
@@ -1089,32 +1048,34 @@ namespace spidermonkey {
     JSBool native_print( JSContext * cx, JSObject * obj, uintN argc, jsval *argv, jsval *rval ) {
         stringstream ss;
         bool someWritten = false;
+        Scope::ShellOutput detached; // print outside of scope execution is not captured
+        Scope::ShellOutput &output = currentScope.get() ? currentScope->shellOutput() : detached;
         try {
             Convertor c( cx );
             for ( uintN i=0; i<argc; i++ ) {
                 if ( i > 0 )
-                    __logs << " ";
+                    output.logs << " ";
 					
 
                 if (!(JSVAL_IS_OBJECT(argv[i])))
                 {
-                    __logs << c.toString(argv[i]);
+                    output.logs << c.toString(argv[i]);
                     someWritten = true;
                     continue;
                 }
 
                 BSONObj obj = c.toObject(argv[i]);
-                robomongo_add_bsonobj(obj);
+                output.addObject(obj);
             }
 
             if ( someWritten )
-                __logs << "\n";
+                output.logs << "\n";
 
        }
         catch ( const AssertionException& ) {
             if ( someWritten ) {
-				__logs << "\n";
-                Logstream::logLockless( __logs.str() );
+				output.logs << "\n";
+                Logstream::logLockless( output.logs.str() );
             }
             return JS_FALSE;
         }
@@ -1133,11 +1094,15 @@ namespace spidermonkey {
                 return JS_TRUE;
             }
 
+            if (!currentScope.get()) {
+                return JS_TRUE;
+            }
+
             std::string type = c.toString(argv[0]);
             if (type.empty()) {
-                robomongo_end();
+                currentScope->shellOutput().end();
             } else {
-                robomongo_begin(type);
+                currentScope->shellOutput().begin(type);
             }
         }
         catch ( const std::exception& e ) {
@@ -1353,6 +1318,12 @@ namespace spidermonkey {
         }
 
         ~SMEngine() {
+#ifdef ROBOMONGO
+            for ( SetupScriptsMap::iterator it = _setupScripts.begin(); it != _setupScripts.end(); ++it ) {
+                JS_RemoveRootRT( _runtime , &it->second.scriptObject );
+            }
+            _setupScripts.clear();
+#endif
             JS_DestroyRuntime( _runtime );
             JS_ShutDown();
         }
@@ -1378,9 +1349,34 @@ namespace spidermonkey {
 #endif
 
 
+#ifdef ROBOMONGO
+        /**
+         * Returns compiled setup script (i.e. embedded shell file). Script is compiled
+         * once per runtime and then executed by every new scope: compiled script is not
+         * bound to global object of the scope, that compiled it (function objects are
+         * cloned into the executing scope).
+         */
+        JSScript * setupScript( JSContext * cx , JSObject * global , const StringData& code , const string& name );
+#endif
+
     private:
         JSRuntime * _runtime;
         friend class SMScope;
+
+#ifdef ROBOMONGO
+        struct SetupScript {
+            SetupScript() : script( 0 ) , scriptObject( 0 ) {}
+            string source;
+            JSScript * script;
+            JSObject * scriptObject;
+        };
+
+        /**
+         * Compiled setup scripts by name. Values are rooted while script is cached.
+         */
+        typedef map<string, SetupScript> SetupScriptsMap;
+        SetupScriptsMap _setupScripts;
+#endif
     };
 
     SMEngine * globalSMEngine;
@@ -1441,6 +1437,11 @@ namespace spidermonkey {
                 _convertor = 0;
             }
 
+#ifdef ROBOMONGO
+            clearPreparedScripts();
+            clearCompiledScripts();
+#endif
+
             if ( _context ) {
                 // This is expected to reclaim _global as well.
                 JS_DestroyContext( _context );
@@ -1685,6 +1686,183 @@ namespace spidermonkey {
             currentScope.reset( this );
     }
 
+#ifdef ROBOMONGO
+    JSScript * SMEngine::setupScript( JSContext * cx , JSObject * global , const StringData& code , const string& name ) {
+        smlock;
+        SetupScript &cached = _setupScripts[ name ];
+        if ( cached.scriptObject && code == StringData( cached.source ) )
+            return cached.script;
+
+        JSScript * script = JS_CompileScript( cx , global , code.rawData() , code.size() , name.c_str() , 1 );
+        if ( ! script )
+            return NULL;
+
+        JSObject * scriptObject = JS_NewScriptObject( cx , script );
+        if ( ! scriptObject ) {
+            JS_DestroyScript( cx , script );
+            return NULL;
+        }
+
+        if ( cached.scriptObject ) {
+            // Name is reused for other code (i.e. not an embedded file)
+            JS_RemoveRoot( cx , &cached.scriptObject );
+        }
+
+        cached.source = code.toString();
+        cached.script = script;
+        cached.scriptObject = scriptObject;
+        JS_AddNamedRoot( cx , &cached.scriptObject , "setup script" );
+        return script;
+    }
+
+    void SMScope::execSetup( const StringData& code , const string& name ) {
+            smlock;
+            precall();
+
+            jsval ret = JSVAL_VOID;
+
+            installInterrupt( 0 );
+            JSScript * script = globalSMEngine->setupScript( _context , _global , code , name );
+            JSBool worked = script && JS_ExecuteScript( _context , _global , script , &ret );
+            uninstallInterrupt( 0 );
+
+            if ( ! worked && _error.size() == 0 ) {
+                jsval v;
+                if ( JS_GetPendingException( _context , &v ) ) {
+                    _error = _convertor->toString( v );
+                }
+            }
+
+            uassert( 10228, mongoutils::str::stream() << name + " exec failed: " << _error, worked );
+
+            _convertor->setProperty( _global , "__lastres__" , ret );
+    }
+#endif
+
+#ifdef ROBOMONGO
+    bool SMScope::isCacheableScript( const StringData& code ) {
+        if ( code.size() > compiledScriptMaxLength )
+            return false;
+
+        // Only scripts with '/' (division, comment or regex) or "function" (may be in string or comment) are lexed
+        if ( code.find( '/' ) == string::npos && code.find( "function" ) == string::npos )
+            return true;
+
+        return ! Robomongo::StatementSplitter::hasCompileTimeObjects( code.toString() );
+    }
+
+    bool SMScope::compiledScript( const StringData& code , const string& name , JSScript *& script ) {
+        script = NULL;
+        if ( code.size() > compiledScriptMaxLength )
+            return false;
+
+        std::pair<string, string> key( code.toString() , name );
+        CompiledScriptsIndex::iterator found = _compiledScriptsIndex.find( key );
+        if ( found != _compiledScriptsIndex.end() ) {
+            _compiledScripts.splice( _compiledScripts.begin() , _compiledScripts , found->second );
+            script = found->second->script;
+            return found->second->cacheable;
+        }
+
+        // Cacheability is checked once: entry of script, that is not cacheable, keeps no script
+        CompiledScriptsList compiled( 1 , CompiledScript( key.first , name ) );
+        bool cacheable = compiled.front().cacheable = isCacheableScript( code );
+        if ( cacheable ) {
+            script = JS_CompileScript( _context , _global , code.rawData() , code.size() , name.c_str() , 1 );
+            if ( ! script )
+                return true;
+
+            JSObject * scriptObject = JS_NewScriptObject( _context , script );
+            if ( ! scriptObject ) {
+                JS_DestroyScript( _context , script );
+                script = NULL;
+                return true;
+            }
+
+            compiled.front().script = script;
+            compiled.front().scriptObject = scriptObject;
+            JS_AddNamedRoot( _context , &compiled.front().scriptObject , "compiled script" );
+        }
+
+        cacheCompiledScript( compiled );
+        return cacheable;
+    }
+
+    void SMScope::cacheCompiledScript( CompiledScriptsList& from ) {
+        CompiledScript &first = from.front();
+        if ( ! first.cacheable )
+            releaseCompiledScript( first );
+
+        std::pair<string, string> key( first.code , first.name );
+        if ( _compiledScriptsIndex.count( key ) ) {
+            releaseCompiledScript( first );
+            from.pop_front();
+            return;
+        }
+
+        _compiledScripts.splice( _compiledScripts.begin() , from , from.begin() );
+        _compiledScriptsIndex[ key ] = _compiledScripts.begin();
+
+        if ( _compiledScripts.size() > compiledScriptsCacheSize ) {
+            CompiledScript &last = _compiledScripts.back();
+            releaseCompiledScript( last );
+            _compiledScriptsIndex.erase( std::make_pair( last.code , last.name ) );
+            _compiledScripts.pop_back();
+        }
+    }
+
+    void SMScope::releaseCompiledScript( CompiledScript& compiled ) {
+        if ( compiled.scriptObject )
+            JS_RemoveRoot( _context , &compiled.scriptObject );
+        compiled.script = NULL;
+        compiled.scriptObject = NULL;
+    }
+
+    void SMScope::clearCompiledScripts() {
+        for ( CompiledScriptsList::iterator it = _compiledScripts.begin(); it != _compiledScripts.end(); ++it ) {
+            releaseCompiledScript( *it );
+        }
+        _compiledScripts.clear();
+        _compiledScriptsIndex.clear();
+    }
+
+    void SMScope::clearPreparedScripts() {
+        for ( CompiledScriptsList::iterator it = _preparedScripts.begin(); it != _preparedScripts.end(); ++it ) {
+            releaseCompiledScript( *it );
+        }
+        _preparedScripts.clear();
+    }
+#endif
+
+#ifdef ROBOMONGO
+    bool SMScope::compile( const StringData& code , const string& name , int lineno , string& error ) {
+            smlock;
+            precall();
+
+            _reportError = false;
+            JSScript * script = JS_CompileScript( _context , _global , code.rawData() , code.size() , name.c_str() , lineno );
+            _reportError = true;
+
+            JSObject * scriptObject = script ? JS_NewScriptObject( _context , script ) : NULL;
+            if ( ! scriptObject ) {
+                if ( script )
+                    JS_DestroyScript( _context , script );
+                error = _error;
+                JS_ClearPendingException( _context );
+                // Nothing of the failed batch is executed
+                clearPreparedScripts();
+                return false;
+            }
+
+            _preparedScripts.push_back( CompiledScript( code.toString() , name ) );
+            CompiledScript &prepared = _preparedScripts.back();
+            prepared.script = script;
+            prepared.scriptObject = scriptObject;
+            JS_AddNamedRoot( _context , &prepared.scriptObject , "prepared script" );
+            return true;
+    }
+#endif
+
     bool SMScope::exec( const StringData& code,
                         const string& name,
                         bool printResult,
@@ -1698,16 +1876,49 @@ namespace spidermonkey {
 
             installInterrupt( timeoutMs );
             _reportError = reportError;
-            JSBool worked = JS_EvaluateScript( _context,
-                                               _global,
-                                               code.rawData(),
-                                               code.size(),
-                                               name.c_str(),
-                                               1,
-                                               &ret );
+            JSBool worked;
+#ifdef ROBOMONGO
+            // Script, compiled by compile(), is executed once and then cached or released
+            CompiledScriptsList prepared;
+            if ( ! _preparedScripts.empty() && _preparedScripts.front().name == name ) {
+                if ( code == StringData( _preparedScripts.front().code ) )
+                    prepared.splice( prepared.begin() , _preparedScripts , _preparedScripts.begin() );
+                else
+                    clearPreparedScripts(); // left by the batch, that wasn't executed
+            }
+
+            JSScript * script = NULL;
+            if ( ! prepared.empty() ) {
+                worked = JS_ExecuteScript( _context , _global , prepared.front().script , &ret );
+            }
+            else if ( compiledScript( code , name , script ) ) {
+                worked = script && JS_ExecuteScript( _context , _global , script , &ret );
+            }
+            else
+#endif
+            worked = JS_EvaluateScript( _context,
+                                        _global,
+                                        code.rawData(),
+                                        code.size(),
+                                        name.c_str(),
+                                        1,
+                                        &ret );
             _reportError = true;
             uninstallInterrupt( timeoutMs );
 
+#ifdef ROBOMONGO
+            if ( ! prepared.empty() ) {
+                CompiledScript &executed = prepared.front();
+                if ( code.size() <= compiledScriptMaxLength && ! _compiledScriptsIndex.count( std::make_pair( executed.code , executed.name ) ) ) {
+                    executed.cacheable = isCacheableScript( code );
+                    cacheCompiledScript( prepared );
+                }
+                else {
+                    releaseCompiledScript( executed );
+                }
+            }
+#endif
+
             if ( ! worked && _error.size() == 0 ) {
                 jsval v;
                 if ( JS_GetPendingException( _context , &v ) ) {
@@ -1724,7 +1935,7 @@ namespace spidermonkey {
                 _convertor->setProperty( _global , "__lastres__" , ret );
 
             if ( worked && printResult && ! JSVAL_IS_VOID( ret ) )
-                __logs << _convertor->toString( ret ) << endl;
+                shellOutput().logs << _convertor->toString( ret ) << endl;
 
             return worked;
     }
@@ -1850,8 +2061,11 @@ namespace spidermonkey {
             ss << " " << report->filename << ":" << report->lineno;
         }
 
-        if ( !currentScope.get() || currentScope->isReportingErrors() ) {
-			__logs << ss.str() << endl;
+        if ( !currentScope.get() ) {
+            log() << ss.str() << endl;
+        }
+        else if ( currentScope->isReportingErrors() ) {
+			currentScope->shellOutput().logs << ss.str() << endl;
             //tlog() << ss.str() << endl;
         }
 
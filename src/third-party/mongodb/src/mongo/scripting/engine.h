@@ -19,6 +19,10 @@
 
 #include "mongo/db/jsobj.h"
 
+#ifdef ROBOMONGO
+#include <sstream>
+#endif
+
 namespace mongo {
     typedef unsigned long long ScriptingFunction;
     typedef BSONObj (*NativeFunction)(const BSONObj& args, void* data);
@@ -168,6 +172,40 @@ namespace mongo {
     public:
         static void setInterruptFlag(bool flag) { _interruptFlag = flag; }
         static volatile bool _interruptFlag;
+
+        /**
+         * Output of the executed shell statement: printed text and documents.
+         * Every scope has its own output, so scopes of different threads
+         * don't share result buffers.
+         */
+        struct ShellOutput {
+            ShellOutput() : finished(false) {}
+
+            void reset();
+            void resetType();
+            void addObject(const BSONObj &obj);
+            void begin(const std::string &requestType);
+            void end();
+
+            std::vector<BSONObj> objects;
+            std::string type;     // type of request
+            bool finished;        // typed request is finished
+            std::stringstream logs;
+        };
+
+        ShellOutput &shellOutput() { return _shellOutput; }
+
+        /**
+         * Compiles script without executing it (syntax check of statements before any of
+         * them is executed). 'lineno' is number of the first line of code in error message.
+         * Compiled script is executed by the next exec() of the same code and name, instead
+         * of compiling it again. Returns false and sets 'error', if script can't be compiled
+         * (scripts, compiled before, are released too).
+         */
+        virtual bool compile(const StringData& code, const string& name, int lineno, string& error) { return true; }
+
+    private:
+        ShellOutput _shellOutput;
 #endif
     };
 
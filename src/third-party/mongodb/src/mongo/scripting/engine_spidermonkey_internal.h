@@ -16,6 +16,7 @@
 #include "mongo/scripting/engine_spidermonkey.h"
 
 #include <list>
+#include <map>
 #include <set>
 #include <string>
 #include <third_party/js-1.7/jsapi.h>
@@ -257,6 +258,15 @@ namespace spidermonkey {
                    bool assertOnError = true,
                    int timeoutMs = 0 );
 
+#ifdef ROBOMONGO
+        /**
+         * Executes setup script, compiled once per process (see SMEngine::setupScript).
+         */
+        virtual void execSetup( const StringData& code , const string& name = "setup" );
+
+        virtual bool compile( const StringData& code , const string& name , int lineno , string& error );
+#endif
+
         int invoke( JSFunction* func,
                     const BSONObj* args,
                     const BSONObj* recv,
@@ -298,6 +308,63 @@ namespace spidermonkey {
     private:
         void _postCreateHacks();
 
+#ifdef ROBOMONGO
+        /**
+         * Limits of cache of compiled scripts, executed by exec() (repeated statements
+         * and helper snippets of the shell are compiled only once).
+         */
+        enum{compiledScriptsCacheSize = 256, compiledScriptMaxLength = 64 * 1024};
+
+        /**
+         * Scripts with regular expression literals or functions are not cached: their objects
+         * are created at compile time and would be shared by executions (lastIndex of RegExp,
+         * properties of function: JSOP_ANONFUNOBJ and JSOP_DEFFUN don't clone function object
+         * in the scope, where it was compiled).
+         */
+        static bool isCacheableScript( const StringData& code );
+
+        /**
+         * Returns false, if script is not cacheable (it should be evaluated). Otherwise sets
+         * 'script' to compiled script from cache (compiling it on miss), or NULL on compile error.
+         * Cacheability is checked only when script is added to cache.
+         */
+        bool compiledScript( const StringData& code , const string& name , JSScript *& script );
+        void clearCompiledScripts();
+
+        struct CompiledScript {
+            CompiledScript( const string& code , const string& name ) :
+                code( code ) , name( name ) , cacheable( false ) , script( 0 ) , scriptObject( 0 ) {}
+            string code;
+            string name;
+            bool cacheable;      // script is not kept for scripts, that are not cacheable
+            JSScript * script;
+            JSObject * scriptObject;
+        };
+
+        /**
+         * Most recently used scripts first, indexed by (code, name).
+         */
+        typedef std::list<CompiledScript> CompiledScriptsList;
+        typedef std::map<std::pair<string, string>, CompiledScriptsList::iterator> CompiledScriptsIndex;
+        CompiledScriptsList _compiledScripts;
+        CompiledScriptsIndex _compiledScriptsIndex;
+
+        /**
+         * Moves first script of 'from' to cache, evicting least recently used script
+         * (script itself is released, if it is not cacheable).
+         */
+        void cacheCompiledScript( CompiledScriptsList& from );
+        void releaseCompiledScript( CompiledScript& compiled );
+
+        /**
+         * Scripts, compiled by compile() and not executed yet, in order of compilation:
+         * exec() of the same code and name executes the first of them instead of compiling
+         * code again (then script is moved to cache, if it is cacheable, or released).
+         */
+        CompiledScriptsList _preparedScripts;
+        void clearPreparedScripts();
+#endif
+
         JSContext * _context;
         Convertor * _convertor;
 
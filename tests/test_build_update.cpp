@@ -0,0 +1,87 @@
+#include "gtest/gtest.h"
+
+#include <mongo/client/dbclient.h>
+#include "robomongo/core/utils/BsonUtils.h"
+
+using namespace Robomongo;
+
+namespace
+{
+    void expectUpdate(const mongo::BSONObj &original, const mongo::BSONObj &edited,
+                      const mongo::BSONObj &expectedUpdate, const mongo::BSONObj &expectedMatch)
+    {
+        mongo::BSONObj update, match;
+        ASSERT_TRUE(BsonUtils::buildUpdate(original, edited, update, match));
+        ASSERT_TRUE(expectedUpdate.binaryEqual(update)) << update.toString();
+        ASSERT_TRUE(expectedMatch.binaryEqual(match)) << match.toString();
+    }
+
+    void expectWholeDocument(const mongo::BSONObj &original, const mongo::BSONObj &edited)
+    {
+        mongo::BSONObj update, match;
+        ASSERT_FALSE(BsonUtils::buildUpdate(original, edited, update, match));
+    }
+}
+
+TEST(BuildUpdateTest, EqualDocuments)
+{
+    mongo::BSONObj doc = BSON("_id" << 1 << "a" << 2 << "s" << BSON("x" << 1));
+    expectUpdate(doc, doc, mongo::BSONObj(), mongo::BSONObj());
+}
+
+TEST(BuildUpdateTest, ChangedNewAndRemovedFields)
+{
+    expectUpdate(BSON("_id" << 1 << "a" << 1 << "b" << "x" << "c" << true),
+                 BSON("_id" << 1 << "a" << 2 << "c" << true << "d" << 5),
+                 BSON("$set" << BSON("a" << 2 << "d" << 5) << "$unset" << BSON("b" << "")),
+                 BSON("a" << 1 << "d" << BSON("$exists" << false) << "b" << "x"));
+}
+
+TEST(BuildUpdateTest, ChangedTypeIsChange)
+{
+    expectUpdate(BSON("_id" << 1 << "a" << 1),
+                 BSON("_id" << 1 << "a" << 1.0),
+                 BSON("$set" << BSON("a" << 1.0)),
+                 BSON("a" << 1));
+}
+
+TEST(BuildUpdateTest, NestedDocumentsUseDottedPaths)
+{
+    expectUpdate(BSON("_id" << 1 << "s" << BSON("x" << 1 << "y" << BSON("z" << 1 << "w" << 2))),
+                 BSON("_id" << 1 << "s" << BSON("x" << 1 << "y" << BSON("z" << 3))),
+                 BSON("$set" << BSON("s.y.z" << 3) << "$unset" << BSON("s.y.w" << "")),
+                 BSON("s.y.z" << 1 << "s.y.w" << 2));
+}
+
+TEST(BuildUpdateTest, ArraysAreSetAsWhole)
+{
+    expectUpdate(BSON("_id" << 1 << "a" << BSON_ARRAY(1 << 2)),
+                 BSON("_id" << 1 << "a" << BSON_ARRAY(1 << 3)),
+                 BSON("$set" << BSON("a" << BSON_ARRAY(1 << 3))),
+                 BSON("a" << BSON_ARRAY(1 << 2)));
+}
+
+TEST(BuildUpdateTest, ReorderedSubdocumentIsSetAsWhole)
+{
+    expectUpdate(BSON("_id" << 1 << "s" << BSON("x" << 1 << "y" << 2)),
+                 BSON("_id" << 1 << "s" << BSON("y" << 2 << "x" << 1)),
+                 BSON("$set" << BSON("s" << BSON("y" << 2 << "x" << 1))),
+                 BSON("s" << BSON("x" << 1 << "y" << 2)));
+}
+
+TEST(BuildUpdateTest, DottedFieldNameIsSetWithParent)
+{
+    expectUpdate(BSON("_id" << 1 << "s" << BSON("a.b" << 1)),
+                 BSON("_id" << 1 << "s" << BSON("a.b" << 2)),
+                 BSON("$set" << BSON("s" << BSON("a.b" << 2))),
+                 BSON("s" << BSON("a.b" << 1)));
+}
+
+TEST(BuildUpdateTest, WholeDocumentWhenIdOrOrderChanged)
+{
+    expectWholeDocument(BSON("_id" << 1 << "a" << 1), BSON("_id" << 2 << "a" << 1));
+    expectWholeDocument(BSON("_id" << 1 << "a" << 1), BSON("a" << 1));
+    expectWholeDocument(BSON("_id" << 1 << "a" << 1 << "b" << 2), BSON("_id" << 1 << "b" << 2 << "a" << 1));
+    expectWholeDocument(BSON("_id" << 1 << "a" << 1), BSON("_id" << 1 << "z" << 1 << "a" << 1));
+    expectWholeDocument(BSON("_id" << 1), BSON("_id" << 1 << "b" << 1 << "a" << 1));
+}
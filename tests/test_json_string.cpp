@@ -0,0 +1,161 @@
+#include "gtest/gtest.h"
+
+#include <mongo/client/dbclient.h>
+#include "robomongo/core/utils/BsonUtils.h"
+
+using namespace Robomongo;
+
+namespace
+{
+    /**
+     * @brief Golden strings were produced by the StringBuilder-based serializer,
+     * that was used before appendJsonString(). Output should stay byte-identical,
+     * because it is shown in text mode and copied to clipboard.
+     */
+    void expectJson(const std::string &expected, const mongo::BSONObj &obj, mongo::JsonStringFormat format, int pretty, bool isArray = false)
+    {
+        ASSERT_EQ(expected, BsonUtils::jsonString(obj, format, pretty, DefaultEncoding, Utc, isArray));
+
+        std::string appended = "prefix";
+        BsonUtils::appendJsonString(appended, obj, format, pretty, DefaultEncoding, Utc, isArray);
+        ASSERT_EQ("prefix" + expected, appended);
+    }
+
+    mongo::OID testOid()
+    {
+        mongo::OID oid;
+        oid.init("0123456789abcdef01234567");
+        return oid;
+    }
+
+    mongo::BSONObj scalarsObject()
+    {
+        mongo::BSONObjBuilder b;
+        b.append("_id", testOid());
+        b.append("i", 5);
+        b.append("d", 2.5);
+        b.append("l", 10LL);
+        b.appendBool("t", false);
+        b.appendNull("n");
+        {
+            mongo::BSONObjBuilder a(b.subarrayStart("a"));
+            a.append("0", 1);
+            a.append("1", "x");
+        }
+        return b.obj();
+    }
+
+    mongo::BSONObj specialTypesObject()
+    {
+        mongo::BSONObjBuilder b;
+        b.appendDBRef("ref", "coll", testOid());
+        b.appendBinData("bin", 3, mongo::BinDataGeneral, "abc");
+        b.appendRegex("re", "^a", "i");
+        b.appendTimestamp("ts", 1400000000000ULL, 7);
+        b.appendMinKey("min");
+        b.appendMaxKey("max");
+        b.append("big", 1234567);
+        b.append("neg", -0.5);
+        b.appendUndefined("u");
+        return b.obj();
+    }
+}
+
+TEST(JsonStringTest, EmptyDocuments)
+{
+    expectJson("{}", mongo::BSONObj(), mongo::TenGen, 1);
+    expectJson("[]", mongo::BSONObj(), mongo::TenGen, 1, true);
+}
+
+TEST(JsonStringTest, ScalarsStrict)
+{
+    expectJson("{ \"_id\" : { \"$oid\" : \"0123456789abcdef01234567\" }, \"i\" : 5, \"d\" : 2.5000000000000000, "
+               "\"l\" : NumberLong(10), \"t\" : false, \"n\" : null, \"a\" : [ 1, \"x\"\n]\n}",
+               scalarsObject(), mongo::Strict, 0);
+}
+
+TEST(JsonStringTest, ScalarsTenGen)
+{
+    expectJson("{ \"_id\" : ObjectId(\"0123456789abcdef01234567\"), \"i\" : 5, \"d\" : 2.5000000000000000, "
+               "\"l\" : NumberLong(10), \"t\" : false, \"n\" : null, \"a\" : [ 1, \"x\"\n]\n}",
+               scalarsObject(), mongo::TenGen, 0);
+}
+
+TEST(JsonStringTest, SpecialTypesStrict)
+{
+    expectJson("{ \"ref\" : { \"$ref\" : \"coll\", \"$id\" : \"0123456789abcdef01234567\"}, "
+               "\"bin\" : { \"$binary\" : \"YWJj\", \"$type\" : \"00\" }, "
+               "\"re\" : { \"$regex\" : \"^a\", \"$options\" : \"i\" }, "
+               "\"ts\" : { \"$timestamp\" : { \"t\" : 1400000000, \"i\" : 7 } }, "
+               "\"min\" : { \"$minKey\" : 1 }, \"max\" : { \"$maxKey\" : 1 }, "
+               "\"big\" : 1.23457e+06, \"neg\" : -0.5000000000000000, \"u\" : undefined\n}",
+               specialTypesObject(), mongo::Strict, 0);
+}
+
+TEST(JsonStringTest, SpecialTypesTenGen)
+{
+    expectJson("{ \"ref\" : DBRef(\"coll\", \"0123456789abcdef01234567\"), "
+               "\"bin\" : { \"$binary\" : \"YWJj\", \"$type\" : \"00\" }, "
+               "\"re\" : /^a/i, \"ts\" : Timestamp(1400000000, 7), "
+               "\"min\" : { \"$minKey\" : 1 }, \"max\" : { \"$maxKey\" : 1 }, "
+               "\"big\" : 1.23457e+06, \"neg\" : -0.5000000000000000, \"u\" : undefined\n}",
+               specialTypesObject(), mongo::TenGen, 0);
+}
+
+TEST(JsonStringTest, DateOutOfIsoRange)
+{
+    mongo::BSONObjBuilder b;
+    b.appendDate("bd", mongo::Date_t(999999999999999ULL));
+    mongo::BSONObj obj = b.obj();
+
+    expectJson("{ \"bd\" : Date(999999999999999)\n}", obj, mongo::TenGen, 0);
+    expectJson("{ \"bd\" : { \"$date\" : 999999999999999 }\n}", obj, mongo::Strict, 0);
+}
+
+TEST(JsonStringTest, EscapedStrings)
+{
+    expectJson("{ \"s\" : \"q\\\"b\\\\s/\\n\\t\\u0001 \xd0\xbf\"\n}",
+               BSON("s" << "q\"b\\s/\n\t\x01 \xd0\xbf"), mongo::Strict, 0);
+}
+
+TEST(JsonStringTest, SparseArray)
+{
+    mongo::BSONObjBuilder b;
+    {
+        mongo::BSONObjBuilder a(b.subarrayStart("sp"));
+        a.append("0", 1);
+        a.append("2", 3);
+    }
+    expectJson("{ \"sp\" : [ 1, undefined, 3\n]\n}", b.obj(), mongo::TenGen, 0);
+}
+
+TEST(JsonStringTest, TopLevelArray)
+{
+    mongo::BSONObj arr = BSON("0" << 1 << "1" << 2);
+    expectJson("[ 1, 2\n]", arr, mongo::TenGen, 0, true);
+    expectJson("[\n    1,\n    2\n]", arr, mongo::TenGen, 1, true);
+}
+
+TEST(JsonStringTest, PrettyNested)
+{
+    expectJson("{\n"
+               "    \"a\" : {\n"
+               "        \"b\" : {\n"
+               "            \"c\" : 1\n"
+               "        }\n"
+               "    },\n"
+               "    \"e\" : {}\n"
+               "}",
+               BSON("a" << BSON("b" << BSON("c" << 1)) << "e" << mongo::BSONObj()), mongo::TenGen, 1);
+}
+
+TEST(JsonStringTest, DeepNestingBeyondIndentBuffer)
+{
+    mongo::BSONObj deep = BSON("leaf" << 1);
+    for (int i = 0; i < 20; ++i)
+        deep = BSON("l" << deep);
+
+    std::string json = BsonUtils::jsonString(deep, mongo::TenGen, 1, DefaultEncoding, Utc);
+    std::string indent(21 * 4, ' ');
+    ASSERT_NE(std::string::npos, json.find("\n" + indent + "\"leaf\" : 1\n"));
+}
@@ -0,0 +1,104 @@
+#include "gtest/gtest.h"
+
+#include <iostream>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/lexical_cast.hpp>
+#include <mongo/client/dbclient.h>
+#include "robomongo/shell/db/json.h"
+
+namespace
+{
+    std::string documentJson(int i)
+    {
+        std::string n = boost::lexical_cast<std::string>(i);
+        return "{ \"_id\" : ObjectId(\"0123456789abcdef01234567\"), \"n\" : " + n +
+               ", name : 'user " + n + "', \"tags\" : [ \"a\", \"b\", 2.5 ], "
+               "\"nested\" : { \"created\" : ISODate(\"2014-01-01T00:00:00Z\"), \"count\" : NumberLong(" + n + ") } }";
+    }
+
+    std::string documentsJson(int count)
+    {
+        std::string json;
+        for (int i = 0; i < count; ++i) {
+            json += documentJson(i);
+            json += "\n";
+        }
+        return json;
+    }
+
+    std::vector<mongo::BSONObj> parseAll(const std::string &json)
+    {
+        std::vector<mongo::BSONObj> result;
+        mongo::Robomongo::fromjson(json.c_str(), json.length(), result);
+        return result;
+    }
+
+    long long parseMilliseconds(const std::string &json, size_t expectedCount)
+    {
+        boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+        std::vector<mongo::BSONObj> result = parseAll(json);
+        boost::posix_time::ptime end = boost::posix_time::microsec_clock::universal_time();
+        EXPECT_EQ(expectedCount, result.size());
+        return (end - start).total_milliseconds();
+    }
+}
+
+TEST(ParserStreamTest, SameAsSingleDocumentParsing)
+{
+    std::string json = documentsJson(100);
+    std::vector<mongo::BSONObj> result = parseAll(json);
+
+    ASSERT_EQ(100u, result.size());
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(mongo::Robomongo::fromjson(documentJson(i)), result[i]);
+        ASSERT_TRUE(result[i].isOwned());
+    }
+}
+
+TEST(ParserStreamTest, WhitespaceAndEmptyInput)
+{
+    ASSERT_TRUE(parseAll("").empty());
+    ASSERT_TRUE(parseAll(" \n\t ").empty());
+
+    std::vector<mongo::BSONObj> result = parseAll("  {a:1}{b:2}\n\n {}  ");
+    ASSERT_EQ(3u, result.size());
+    ASSERT_EQ(BSON("a" << 1), result[0]);
+    ASSERT_EQ(BSON("b" << 2), result[1]);
+    ASSERT_TRUE(result[2].isEmpty());
+}
+
+TEST(ParserStreamTest, ParsesOnlyGivenLength)
+{
+    std::string json = "{a:1} {b:2}";
+    std::vector<mongo::BSONObj> result;
+    mongo::Robomongo::fromjson(json.c_str(), 5, result);
+    ASSERT_EQ(1u, result.size());
+    ASSERT_EQ(BSON("a" << 1), result[0]);
+}
+
+TEST(ParserStreamTest, ErrorOffsetFromBeginningOfBuffer)
+{
+    std::string json = "{a:1}\n{b:2}\n{c:}";
+    try {
+        parseAll(json);
+        FAIL() << "Parsing should fail";
+    } catch (const mongo::ParseMsgAssertionException &ex) {
+        ASSERT_EQ(static_cast<int>(json.length()) - 1, ex.offset());
+    }
+}
+
+TEST(ParserStreamTest, BenchmarkMultiMegabyteInput)
+{
+    const int count = 25000;
+    std::string small = documentsJson(count);
+    std::string large = small + small;
+    ASSERT_GT(large.size(), 5u * 1024 * 1024);
+
+    long long smallTime = parseMilliseconds(small, count);
+    long long largeTime = parseMilliseconds(large, 2 * count);
+
+    std::cout << "[ BENCHMARK] " << small.size() << " bytes: " << smallTime << " ms, "
+              << large.size() << " bytes: " << largeTime << " ms" << std::endl;
+    RecordProperty("SmallInputMilliseconds", static_cast<int>(smallTime));
+    RecordProperty("LargeInputMilliseconds", static_cast<int>(largeTime));
+}
@@ -0,0 +1,369 @@
+#include "gtest/gtest.h"
+
+#include <cctype>
+#include "robomongo/core/engine/StatementSplitter.h"
+
+using namespace Robomongo;
+
+namespace
+{
+    /**
+     * @brief Expected statements are the ranges of Program.body items,
+     * returned by esprima.parse(script, { range: true }), without white space
+     * after the last token (see also SameAsEsprima test).
+     */
+    void expectStatements(const std::string &script, const char *expected[])
+    {
+        std::vector<std::string> statements;
+        std::string error;
+        ASSERT_TRUE(StatementSplitter::split(script, statements, error)) << error;
+
+        std::vector<std::string> expectedStatements;
+        for (const char **it = expected; *it; ++it)
+            expectedStatements.push_back(*it);
+
+        ASSERT_EQ(expectedStatements, statements);
+    }
+
+    void expectError(const std::string &script, const std::string &expectedError)
+    {
+        std::vector<std::string> statements;
+        std::string error;
+        ASSERT_FALSE(StatementSplitter::split(script, statements, error));
+        ASSERT_TRUE(statements.empty());
+        ASSERT_EQ(expectedError, error);
+    }
+}
+
+TEST(StatementSplitterTest, SingleStatement)
+{
+    const char *expected[] = { "db.users.find()", NULL };
+    expectStatements("db.users.find()", expected);
+}
+
+TEST(StatementSplitterTest, EmptyScript)
+{
+    const char *expected[] = { NULL };
+    expectStatements("", expected);
+    expectStatements("  \n\t// comment\n/* block\ncomment */\n", expected);
+}
+
+TEST(StatementSplitterTest, Semicolons)
+{
+    const char *expected[] = { "db.a.find();", "db.b.find();", NULL };
+    expectStatements("db.a.find(); db.b.find();", expected);
+}
+
+TEST(StatementSplitterTest, EmptyStatements)
+{
+    const char *expected[] = { ";", ";", NULL };
+    expectStatements(";;", expected);
+}
+
+TEST(StatementSplitterTest, AutomaticSemicolons)
+{
+    const char *expected[] = { "db.a.find()", "db.b.find()", "x", "++y", NULL };
+    expectStatements("db.a.find()\r\ndb.b.find()\nx\n++y", expected);
+}
+
+TEST(StatementSplitterTest, ContinuedLines)
+{
+    const char *expected[] = {
+        "var a = b\n(function() { return 1; })()",
+        "a = b\n+ c",
+        "db.c.find({ name: /^a\\/b/i })\n  .sort({ name: 1 })\n  .limit(5)",
+        "x = [1,\n 2]",
+        NULL
+    };
+    expectStatements(
+        "var a = b\n(function() { return 1; })()\n"
+        "a = b\n+ c\n"
+        "db.c.find({ name: /^a\\/b/i })\n  .sort({ name: 1 })\n  .limit(5)\n"
+        "x = [1,\n 2]", expected);
+}
+
+TEST(StatementSplitterTest, StringsAndComments)
+{
+    const char *expected[] = { "var s = 'a;b\\'}';", "var t = \"c\\\"d;\"", NULL };
+    expectStatements("// comment;\nvar s = 'a;b\\'}'; /* block; } */ var t = \"c\\\"d;\" // ;\n", expected);
+}
+
+TEST(StatementSplitterTest, CommentsBetweenStatements)
+{
+    const char *expected[] = { "a = 1", "b = 2", NULL };
+    expectStatements("a = 1 /* multi\nline */ b = 2", expected);
+}
+
+TEST(StatementSplitterTest, RegexAndDivision)
+{
+    const char *expected[] = { "var r = /;[}/]\\//g;", "x = a / b / c", "y", NULL };
+    expectStatements("var r = /;[}/]\\//g; x = a / b / c\ny", expected);
+}
+
+TEST(StatementSplitterTest, RegexAfterControlHeader)
+{
+    const char *expected[] = { "if (a) /[)]/.test(b);", "c", NULL };
+    expectStatements("if (a) /[)]/.test(b); c", expected);
+}
+
+TEST(StatementSplitterTest, FunctionDeclaration)
+{
+    const char *expected[] = { "function f(a, b) {\n  return a + b;\n}", "f(1, 2)", NULL };
+    expectStatements("function f(a, b) {\n  return a + b;\n}\nf(1, 2)", expected);
+}
+
+TEST(StatementSplitterTest, FunctionDeclarationOnOneLine)
+{
+    const char *expected[] = { "function f() {}", "(1)", NULL };
+    expectStatements("function f() {}(1)", expected);
+}
+
+TEST(StatementSplitterTest, FunctionExpression)
+{
+    const char *expected[] = { "var f = function g()\n{\n}", "f()", NULL };
+    expectStatements("var f = function g()\n{\n}\nf()", expected);
+}
+
+TEST(StatementSplitterTest, ObjectLiteral)
+{
+    const char *expected[] = { "var o = {\n  a: 1,\n  b: function() { return 2; }\n}", "o.b()", NULL };
+    expectStatements("var o = {\n  a: 1,\n  b: function() { return 2; }\n}\no.b()", expected);
+}
+
+TEST(StatementSplitterTest, BlockStatement)
+{
+    const char *expected[] = { "{ a(); b() }", "c()", NULL };
+    expectStatements("{ a(); b() } c()", expected);
+}
+
+TEST(StatementSplitterTest, IfElse)
+{
+    const char *expected[] = {
+        "if (a) {\n  x();\n}\nelse if (b) {\n  y();\n} else {\n  z();\n}",
+        "if (a) x(); else y();",
+        "if (a)\n  b()\nelse\n  c()",
+        "d()",
+        NULL
+    };
+    expectStatements(
+        "if (a) {\n  x();\n}\nelse if (b) {\n  y();\n} else {\n  z();\n}\n"
+        "if (a) x(); else y(); "
+        "if (a)\n  b()\nelse\n  c()\n"
+        "d()", expected);
+}
+
+TEST(StatementSplitterTest, Loops)
+{
+    const char *expected[] = {
+        "for (var i = 0; i < 10; i++) {\n  print(i);\n}",
+        "while (i--) print(i);",
+        "do {\n  i++;\n} while (i < 10);",
+        "do i++; while (i < 20)",
+        "for (var key in obj)\n  print(key)",
+        "print('done')",
+        NULL
+    };
+    expectStatements(
+        "for (var i = 0; i < 10; i++) {\n  print(i);\n}\n"
+        "while (i--) print(i);\n"
+        "do {\n  i++;\n} while (i < 10);\n"
+        "do i++; while (i < 20)\n"
+        "for (var key in obj)\n  print(key)\n"
+        "print('done')", expected);
+}
+
+TEST(StatementSplitterTest, TryCatchFinally)
+{
+    const char *expected[] = { "try {\n  f();\n} catch (e) {\n  print(e);\n}\nfinally {\n  g();\n}", "h()", NULL };
+    expectStatements("try {\n  f();\n} catch (e) {\n  print(e);\n}\nfinally {\n  g();\n}\nh()", expected);
+}
+
+TEST(StatementSplitterTest, Switch)
+{
+    const char *expected[] = { "switch (x) {\n  case 1: a(); break;\n  default: b();\n}", "c()", NULL };
+    expectStatements("switch (x) {\n  case 1: a(); break;\n  default: b();\n}\nc()", expected);
+}
+
+TEST(StatementSplitterTest, KeywordsAsPropertyNames)
+{
+    const char *expected[] = { "db.if.find()", "x.function(1)", NULL };
+    expectStatements("db.if.find()\nx.function(1)", expected);
+}
+
+TEST(StatementSplitterTest, ShellHelpers)
+{
+    const char *expected[] = { "shellHelper('show', 'dbs');", "db.x.count()", NULL };
+    expectStatements("shellHelper('show', 'dbs');\ndb.x.count()", expected);
+}
+
+TEST(StatementSplitterTest, Utf8)
+{
+    // Ranges are in bytes of UTF-8, not in characters
+    const char *expected[] = { "print('\xd0\xbf\xd1\x80\xd0\xb8');", "\xd0\xb0 = 1", NULL };
+    expectStatements("print('\xd0\xbf\xd1\x80\xd0\xb8'); \xd0\xb0 = 1", expected);
+}
+
+TEST(StatementSplitterTest, UnexpectedEndOfInput)
+{
+    expectError("db.a.find(", "Error: Line 1: Unexpected end of input");
+    expectError("if (a)\n", "Error: Line 2: Unexpected end of input");
+    expectError("do {\n} ", "Error: Line 2: Unexpected end of input");
+}
+
+TEST(StatementSplitterTest, UnexpectedToken)
+{
+    expectError("a = 1;\nb)", "Error: Line 2: Unexpected token )");
+    expectError("f(a]", "Error: Line 1: Unexpected token ]");
+}
+
+TEST(StatementSplitterTest, IllegalToken)
+{
+    expectError("print('abc", "Error: Line 1: Unexpected token ILLEGAL");
+    expectError("print('abc\n')", "Error: Line 1: Unexpected token ILLEGAL");
+    expectError("a = 1\n/* open", "Error: Line 2: Unexpected token ILLEGAL");
+    expectError("a = #1", "Error: Line 1: Unexpected token ILLEGAL");
+}
+
+TEST(StatementSplitterTest, UnterminatedRegex)
+{
+    expectError("x = /abc\n", "Error: Line 1: Invalid regular expression: missing /");
+}
+
+namespace
+{
+    struct EsprimaCase
+    {
+        const char *script;
+        const char *statements[4];
+    };
+
+    /**
+     * @brief Output of esprima.js 1.1.0-dev (the version, that Robomongo used before
+     * StatementSplitter): Program.body ranges of esprima.parse(script, { range: true }).
+     */
+    const EsprimaCase esprimaCases[] = {
+        { "a = {} / 2",
+          { "a = {} / 2", NULL } },
+        { "x = {a: 1} / 2; y = 3",
+          { "x = {a: 1} / 2;", "y = 3", NULL } },
+        { "var f = function() {} / 1\nf",
+          { "var f = function() {} / 1\n", "f", NULL } },
+        { "function f() {}\n/a/.test('a')",
+          { "function f() {}", "/a/.test('a')", NULL } },
+        { "if (x) { y() }\n/b/.exec(s)",
+          { "if (x) { y() }", "/b/.exec(s)", NULL } },
+        { "if (a) /re/.test(s)",
+          { "if (a) /re/.test(s)", NULL } },
+        { "(a + b) / 2 / c",
+          { "(a + b) / 2 / c", NULL } },
+        { "do x(); while (a) /re/.test(s)",
+          { "do x(); while (a)", "/re/.test(s)", NULL } },
+        { "db.c.find({ a: { $gt: 1 } }).count() / 2",
+          { "db.c.find({ a: { $gt: 1 } }).count() / 2", NULL } },
+        { "var o = { f: function() { return {} / 2 } }",
+          { "var o = { f: function() { return {} / 2 } }", NULL } },
+        { "function g() { if (a) {} /x/.test(b); return { c: 1 } / 2 }\ng()",
+          { "function g() { if (a) {} /x/.test(b); return { c: 1 } / 2 }", "g()", NULL } },
+        { "x = a\n/ 2 / b",
+          { "x = a\n/ 2 / b", NULL } },
+        { "for (var i = 0; i < 3; i++) { print(i / 2) }",
+          { "for (var i = 0; i < 3; i++) { print(i / 2) }", NULL } },
+        { "db.c.drop(); var v = 5",
+          { "db.c.drop();", "var v = 5", NULL } },
+        { "try { a() } catch (e) { print(e) } finally { b() }\nc()",
+          { "try { a() } catch (e) { print(e) } finally { b() }", "c()", NULL } },
+        { "switch (x) { case 1: y = {} / 2; break; default: z() }",
+          { "switch (x) { case 1: y = {} / 2; break; default: z() }", NULL } },
+        { "var s = 'a/b' + \"c//d\" // comment / here\nt = s.split('/')",
+          { "var s = 'a/b' + \"c//d\" // comment / here\n", "t = s.split('/')", NULL } },
+        { "x = y /* c */ / z",
+          { "x = y /* c */ / z", NULL } },
+        { "label: for (;;) { break label }",
+          { "label: for (;;) { break label }", NULL } },
+        { "a = [1, 2] / 2\nb = (c) / d",
+          { "a = [1, 2] / 2\n", "b = (c) / d", NULL } },
+        { "var re = /[/]/g, n = 4 / 2",
+          { "var re = /[/]/g, n = 4 / 2", NULL } },
+        { "{ a() }\n/x/.test(y)",
+          { "{ a() }", "/x/.test(y)", NULL } },
+        { "x = function () { return /a/ }()\n/ 2",
+          { "x = function () { return /a/ }()\n/ 2", NULL } },
+        { "while (a) b()\nc()",
+          { "while (a) b()\n", "c()", NULL } },
+        { "if (a) b(); else c()\nd()",
+          { "if (a) b(); else c()\n", "d()", NULL } }
+    };
+
+    /**
+     * @brief Esprima includes white space and comments after statement, that is
+     * ended by automatic semicolon, into its range. Splitter ends statement at
+     * its last token, so only this trailing part may differ.
+     */
+    bool isSameStatement(const std::string &esprima, const std::string &statement)
+    {
+        if (esprima.compare(0, statement.size(), statement) != 0)
+            return false;
+
+        size_t pos = statement.size();
+        while (pos < esprima.size()) {
+            if (isspace(static_cast<unsigned char>(esprima[pos]))) {
+                ++pos;
+            } else if (esprima.compare(pos, 2, "//") == 0) {
+                pos = esprima.find('\n', pos);
+            } else if (esprima.compare(pos, 2, "/*") == 0) {
+                pos = esprima.find("*/", pos);
+                if (pos == std::string::npos)
+                    return false;
+                pos += 2;
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+TEST(StatementSplitterTest, SameAsEsprima)
+{
+    for (size_t i = 0; i < sizeof(esprimaCases) / sizeof(esprimaCases[0]); ++i) {
+        const EsprimaCase &esprimaCase = esprimaCases[i];
+        std::vector<std::string> statements;
+        std::string error;
+        ASSERT_TRUE(StatementSplitter::split(esprimaCase.script, statements, error)) << esprimaCase.script << ": " << error;
+
+        size_t count = 0;
+        for (const char *const *it = esprimaCase.statements; *it; ++it) {
+            ASSERT_LT(count, statements.size()) << esprimaCase.script;
+            ASSERT_TRUE(isSameStatement(*it, statements[count])) << esprimaCase.script << ": " << statements[count];
+            ++count;
+        }
+        ASSERT_EQ(count, statements.size()) << esprimaCase.script;
+    }
+}
+
+TEST(StatementSplitterTest, StatementLines)
+{
+    std::vector<std::string> statements;
+    std::vector<int> lines;
+    std::string error;
+    ASSERT_TRUE(StatementSplitter::split("a = 1; b = 2\n\n// c\nif (a) {\n}\r\nd()", statements, lines, error)) << error;
+
+    std::vector<int> expected;
+    expected.push_back(1);
+    expected.push_back(1);
+    expected.push_back(4);
+    expected.push_back(6);
+    ASSERT_EQ(expected, lines);
+}
+
+TEST(StatementSplitterTest, HasCompileTimeObjects)
+{
+    ASSERT_TRUE(StatementSplitter::hasCompileTimeObjects("db.c.find({ name: /^a/ })"));
+    ASSERT_TRUE(StatementSplitter::hasCompileTimeObjects("function f() {}\n/a/.test(s)"));
+    ASSERT_TRUE(StatementSplitter::hasCompileTimeObjects("x = 'unterminated"));
+    ASSERT_FALSE(StatementSplitter::hasCompileTimeObjects("a = b / 2 // comment"));
+    ASSERT_FALSE(StatementSplitter::hasCompileTimeObjects("a = {} / 2; load('/tmp/a.js') /* c */"));
+    ASSERT_TRUE(StatementSplitter::hasCompileTimeObjects("f = function() {}; f.count = (f.count || 0) + 1"));
+    ASSERT_TRUE(StatementSplitter::hasCompileTimeObjects("db.c.find().forEach(function(d) { print(d) })"));
+    ASSERT_FALSE(StatementSplitter::hasCompileTimeObjects("db.c.find({ type: 'function' }) // function"));
+}